@@ -0,0 +1,141 @@
+#include "GPIO.h"
+#include "TWI.h"
+#include "Hardware/TWI.h"
+#include "LCD.h"
+#include "Driver/PCD8544.h"
+#include "Driver/HD44780.h"
+#include "Adapter/PP7W.h"
+#include "Adapter/SR3W.h"
+#include "Adapter/SR4W.h"
+#include "Adapter/MJKDZ.h"
+#include "Adapter/GY_IICLCD.h"
+#include "Adapter/DFRobot_IIC.h"
+#include "Shield/LCD4884.h"
+#include "Shield/LCD_Keypad.h"
+#include "Suite.h"
+
+// Run the benchmark workload matrix against all configured targets
+// and print the results as CSV or JSON. Results are compared with
+// the baselines; the status is "regression" when a workload is more
+// than the threshold slower. Run with the BASELINE format to print
+// new baselines.
+
+// Configure: Output format; CSV, JSON or BASELINE. May be given as
+// build flag, e.g. -DSUITE_FORMAT=BASELINE
+#if !defined(SUITE_FORMAT)
+#define SUITE_FORMAT CSV
+#endif
+Suite::Runner suite(Serial, Suite::Runner::SUITE_FORMAT);
+
+// Configure: Targets; HD44780 with adapters, PCD8544, LCD4884 or
+// LCD Keypad. Select with build flags, without editing the sketch;
+// -DSUITE_MJKDZ, -DSUITE_SR4W, -DSUITE_SR3W, -DSUITE_PCD8544,
+// -DSUITE_LCD4884 and -DSUITE_LCD_KEYPAD, e.g. arduino-cli compile
+// --build-property "build.extra_flags=-DSUITE_MJKDZ -DSUITE_PCD8544".
+// LCD Keypad is the default. Targets should not share pins. The host
+// build runs all targets but LCD4884 with simulated adapters and bus.
+#if defined(ARDUINO_ARCH_HOST)
+#define SUITE_MJKDZ
+#define SUITE_SR4W
+#define SUITE_SR3W
+#define SUITE_PCD8544
+#define SUITE_LCD_KEYPAD
+#elif !defined(SUITE_MJKDZ) && !defined(SUITE_SR4W)		\
+  && !defined(SUITE_SR3W) && !defined(SUITE_PCD8544)		\
+  && !defined(SUITE_LCD4884) && !defined(SUITE_LCD_KEYPAD)
+#define SUITE_LCD_KEYPAD
+#endif
+
+// Configure: Baselines; us per workload (string, number, clear, fill,
+// cursor, scroll, custom), zero for none. The host baselines are in
+// virtual time and generated with the BASELINE format; the hardware
+// baselines should be generated on the board
+#if defined(ARDUINO_ARCH_HOST)
+#define SUITE_BASELINE(target, ...)					\
+  const uint16_t target ## _baseline[] PROGMEM = { __VA_ARGS__ }
+#else
+#define SUITE_BASELINE(target, ...)					\
+  const uint16_t target ## _baseline[] PROGMEM = { 0, 0, 0, 0, 0, 0, 0 }
+#endif
+
+#if defined(SUITE_MJKDZ)
+Hardware::TWI twi(400000UL);
+Suite::TWI_Meter bus(twi);
+LCD::MJKDZ mjkdz(bus);
+HD44780 lcd1(mjkdz);
+SUITE_BASELINE(lcd1, 1162, 1693, 1718, 5563, 469, 2359, 7777);
+#endif
+
+#if defined(SUITE_SR4W)
+#if defined(ARDUINO_ARCH_HOST)
+Suite::Metered<LCD::SR4W<BOARD::D13, BOARD::D12, BOARD::D11, BOARD::D10> > sr4w;
+#else
+Suite::Metered<LCD::SR4W<BOARD::D7, BOARD::D6, BOARD::D5, BOARD::D4> > sr4w;
+#endif
+HD44780 lcd2(sr4w);
+SUITE_BASELINE(lcd2, 520, 740, 1609, 2236, 168, 1092, 3556);
+#endif
+
+#if defined(SUITE_SR3W)
+#if defined(ARDUINO_ARCH_HOST)
+Suite::Metered<LCD::SR3W<BOARD::D13, BOARD::D12, BOARD::D11> > sr3w;
+#else
+Suite::Metered<LCD::SR3W<BOARD::D7, BOARD::D6, BOARD::D5> > sr3w;
+#endif
+HD44780 lcd3(sr3w);
+SUITE_BASELINE(lcd3, 520, 740, 1609, 2236, 168, 1092, 3556);
+#endif
+
+#if defined(SUITE_PCD8544)
+typedef Suite::Metered_Port<SRPO<MSBFIRST, BOARD::D3, BOARD::D2> > pcd8544_port;
+PCD8544<BOARD::D5, BOARD::D4, BOARD::D3, BOARD::D2, pcd8544_port> lcd4;
+SUITE_BASELINE(lcd4, 1, 1, 1, 1, 1, 1, 0);
+#endif
+
+#if defined(SUITE_LCD_KEYPAD)
+LCD_Keypad lcd5;
+SUITE_BASELINE(lcd5, 520, 740, 1609, 2236, 168, 1092, 3556);
+#endif
+
+#if defined(SUITE_LCD4884)
+LCD4884 lcd6;
+SUITE_BASELINE(lcd6, 0, 0, 0, 0, 0, 0, 0);
+#endif
+
+Suite::Target target[] = {
+#if defined(SUITE_MJKDZ)
+  { "MJKDZ", &lcd1, &lcd1, &bus, lcd1_baseline },
+#endif
+#if defined(SUITE_SR4W)
+  { "SR4W", &lcd2, &lcd2, &sr4w, lcd2_baseline },
+#endif
+#if defined(SUITE_SR3W)
+  { "SR3W", &lcd3, &lcd3, &sr3w, lcd3_baseline },
+#endif
+#if defined(SUITE_PCD8544)
+  { "PCD8544", &lcd4, NULL, &pcd8544_port::meter(), lcd4_baseline },
+#endif
+#if defined(SUITE_LCD_KEYPAD)
+  { "LCD_Keypad", &lcd5, &lcd5, NULL, lcd5_baseline },
+#endif
+#if defined(SUITE_LCD4884)
+  { "LCD4884", &lcd6, NULL, NULL, lcd6_baseline },
+#endif
+};
+
+void setup()
+{
+  Serial.begin(57600);
+  while (!Serial);
+}
+
+void loop()
+{
+  uint16_t regressions = suite.run(target, sizeof(target) / sizeof(target[0]));
+  if (regressions != 0) {
+    Serial.print(F("# regressions: "));
+    Serial.println(regressions);
+  }
+  Serial.println();
+  delay(5000);
+}
@@ -0,0 +1,490 @@
+/**
+ * @file BenchmarkSuite/Suite.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef BENCHMARK_SUITE_H
+#define BENCHMARK_SUITE_H
+
+#include "LCD.h"
+#include "Driver/HD44780.h"
+#include "TWI.h"
+
+/**
+ * Benchmark suite; runs the same workload matrix against a table of
+ * targets (device driver and adapter) and prints one result record
+ * per target and workload. The result is the average time per
+ * workload (us), workloads per second, bus bytes per workload and
+ * the change against a stored baseline (us) for the target.
+ */
+namespace Suite {
+
+/**
+ * Bus byte counter.
+ */
+class Meter {
+public:
+  /**
+   * Construct meter with zero count.
+   */
+  Meter() : m_bytes(0) {}
+
+  /**
+   * Return number of bytes.
+   * @return bytes.
+   */
+  uint32_t bytes() const
+  {
+    return (m_bytes);
+  }
+
+protected:
+  uint32_t m_bytes;		//!< Number of bytes.
+};
+
+/**
+ * TWI bus meter; forwards transactions to the given bus and counts
+ * the bytes on the bus, address byte included.
+ */
+class TWI_Meter : public ::TWI, public Meter {
+public:
+  /**
+   * Construct meter for given bus.
+   * @param[in] twi bus.
+   */
+  TWI_Meter(::TWI& twi) :
+    ::TWI(),
+    Meter(),
+    m_twi(twi)
+  {}
+
+  /**
+   * @override{TWI}
+   * Read given number of bytes from device with given address.
+   * @param[in] addr device address.
+   * @param[in] buf pointer to buffer.
+   * @param[in] count number of bytes to read.
+   * @return number of bytes or negative error code.
+   */
+  virtual int read(uint8_t addr, void* buf, size_t count)
+  {
+    m_bytes += count + 1;
+    return (m_twi.read(addr, buf, count));
+  }
+
+  /**
+   * @override{TWI}
+   * Write given buffer to device with given address.
+   * @param[in] addr device address.
+   * @param[in] buf pointer to buffer.
+   * @param[in] count number of bytes to write.
+   * @return number of bytes or negative error code.
+   */
+  virtual int write(uint8_t addr, const void* buf, size_t count)
+  {
+    m_bytes += count + 1;
+    return (m_twi.write(addr, buf, count));
+  }
+
+protected:
+  ::TWI& m_twi;			//!< Measured bus.
+};
+
+/**
+ * HD44780 adapter meter; counts the bytes and nibbles written to
+ * the adapter. Used for adapters without a shared bus (GPIO, shift
+ * register and SPI). Only the outermost write is counted; adapter
+ * writes implemented with the other write member functions (e.g.
+ * write8n() with write8b()) are not counted again.
+ * @param[in] ADAPTER HD44780 adapter class.
+ */
+template<typename ADAPTER>
+class Metered : public ADAPTER, public Meter {
+public:
+  /**
+   * Construct adapter.
+   */
+  Metered() : ADAPTER(), Meter(), m_depth(0) {}
+
+  /**
+   * Construct adapter on given TWI bus.
+   * @param[in] twi bus.
+   */
+  Metered(::TWI& twi) : ADAPTER(twi), Meter(), m_depth(0) {}
+
+  /**
+   * @override{HD44780::Adapter}
+   * Count and write nibble.
+   * @param[in] data (4b) to write.
+   */
+  virtual void write4b(uint8_t data)
+  {
+    if (m_depth++ == 0) m_bytes += 1;
+    ADAPTER::write4b(data);
+    m_depth -= 1;
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Count and write byte.
+   * @param[in] data (8b) to write.
+   */
+  virtual void write8b(uint8_t data)
+  {
+    if (m_depth++ == 0) m_bytes += 1;
+    ADAPTER::write8b(data);
+    m_depth -= 1;
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Count and write buffer.
+   * @param[in] buf pointer to buffer.
+   * @param[in] size number of bytes in buffer.
+   */
+  virtual void write8n(const void* buf, size_t size)
+  {
+    if (m_depth++ == 0) m_bytes += size;
+    ADAPTER::write8n(buf, size);
+    m_depth -= 1;
+  }
+
+protected:
+  uint8_t m_depth;		//!< Write nesting depth.
+};
+
+/**
+ * Serial output port meter; counts the bytes written with the given
+ * port class (e.g. SRPO). Used as the port class of device drivers
+ * with a port parameter (PCD8544). The count is shared by all ports
+ * of the same class.
+ * @param[in] PORT serial output port class.
+ */
+template<typename PORT>
+class Metered_Port : public PORT {
+public:
+  /**
+   * Count and write byte.
+   * @param[in] value to write.
+   */
+  void write(uint8_t value)
+  {
+    s_meter.count(1);
+    PORT::write(value);
+  }
+
+  /**
+   * Return meter for the port class.
+   * @return meter.
+   */
+  static Meter& meter()
+  {
+    return (s_meter);
+  }
+
+protected:
+  /** Meter with counting access. */
+  class Counter : public Meter {
+  public:
+    void count(uint32_t bytes) { m_bytes += bytes; }
+  };
+
+  static Counter s_meter;	//!< Bytes written with the port class.
+};
+
+template<typename PORT>
+typename Metered_Port<PORT>::Counter Metered_Port<PORT>::s_meter;
+
+/**
+ * Benchmark target; device, optional HD44780 driver for the custom
+ * character workload, optional bus meter and optional baseline in
+ * program memory (us per workload, zero for none).
+ */
+struct Target {
+  const char* name;		//!< Target name.
+  LCD::Device* lcd;		//!< Device driver.
+  HD44780* hd44780;		//!< HD44780 driver or NULL.
+  Meter* meter;			//!< Bus meter or NULL.
+  const uint16_t* baseline;	//!< Baseline (us) in program memory or NULL.
+};
+
+/**
+ * Benchmark runner.
+ */
+class Runner {
+public:
+  /** Workloads. */
+  enum {
+    STRING,			//!< Print string.
+    NUMBER,			//!< Print numbers.
+    CLEAR,			//!< Clear display.
+    FILL,			//!< Fill display.
+    CURSOR,			//!< Cursor moves.
+    SCROLL,			//!< New-line on last line.
+    CUSTOM,			//!< Custom characters (HD44780).
+    WORKLOAD_MAX		//!< Number of workloads.
+  } __attribute__((packed));
+
+  /** Output formats. */
+  enum {
+    CSV,			//!< Comma separated values with header.
+    JSON,			//!< JSON object per line.
+    BASELINE			//!< Baseline initializer per target.
+  } __attribute__((packed));
+
+  /**
+   * Construct runner with given output stream, format, regression
+   * threshold and number of repeats per workload.
+   * @param[in] out output stream.
+   * @param[in] format output format (Default CSV).
+   * @param[in] threshold regression threshold in percent (Default 10).
+   * @param[in] repeat number of runs per workload (Default 4).
+   */
+  Runner(Print& out, uint8_t format = CSV, uint8_t threshold = 10,
+	 uint8_t repeat = 4) :
+    m_out(out),
+    m_format(format),
+    m_threshold(threshold),
+    m_repeat(repeat == 0 ? 1 : repeat)
+  {}
+
+  /**
+   * Run the workloads on the given targets and print the results.
+   * Returns number of regressions; workloads slower than the
+   * baseline by more than the threshold.
+   * @param[in] target table of targets.
+   * @param[in] count number of targets.
+   * @return number of regressions.
+   */
+  uint16_t run(Target* target, uint8_t count)
+  {
+    uint16_t res = 0;
+    if (m_format == CSV)
+      m_out.println(F("target,workload,us,ops,bytes,baseline,delta,status"));
+    for (uint8_t i = 0; i < count; i++)
+      res += run(target[i]);
+    return (res);
+  }
+
+  /**
+   * Run the workloads on the given target and print the results.
+   * Returns number of regressions.
+   * @param[in] target benchmark target.
+   * @return number of regressions.
+   */
+  uint16_t run(Target& target)
+  {
+    LCD::Device& lcd = *target.lcd;
+    uint16_t res = 0;
+    if (m_format == BASELINE) m_out.print(F("  {"));
+    lcd.begin();
+    for (uint8_t ix = 0; ix < WORKLOAD_MAX; ix++) {
+      // Start each workload on a clear display
+      lcd.display_clear();
+      lcd.flush();
+      uint32_t bytes = (target.meter != NULL ? target.meter->bytes() : 0);
+      uint32_t start = micros();
+      bool done = true;
+      for (uint8_t i = 0; i < m_repeat && done; i++) {
+	done = workload(ix, target);
+	lcd.flush();
+      }
+      uint32_t us = (micros() - start) / m_repeat;
+      if (target.meter != NULL)
+	bytes = (target.meter->bytes() - bytes) / m_repeat;
+      uint16_t baseline = 0;
+      if (target.baseline != NULL)
+	baseline = pgm_read_word(&target.baseline[ix]);
+      int32_t delta = 0;
+      if (baseline != 0)
+	delta = (((int32_t) us - baseline) * 100) / baseline;
+      const __FlashStringHelper* status;
+      if (!done) status = F("skip");
+      else if (baseline == 0) status = F("none");
+      else if (delta > m_threshold) status = F("regression");
+      else if (delta < -m_threshold) status = F("improved");
+      else status = F("ok");
+      if (done && baseline != 0 && delta > m_threshold) res += 1;
+      report(target, ix, done ? us : 0, bytes, baseline, delta, status);
+    }
+    lcd.end();
+    if (m_format == BASELINE) {
+      m_out.print(F(" }, // "));
+      m_out.println(target.name);
+    }
+    return (res);
+  }
+
+  /**
+   * Return name of given workload.
+   * @param[in] ix workload.
+   * @return name.
+   */
+  static const __FlashStringHelper* name(uint8_t ix)
+  {
+    switch (ix) {
+    case STRING: return (F("string"));
+    case NUMBER: return (F("number"));
+    case CLEAR: return (F("clear"));
+    case FILL: return (F("fill"));
+    case CURSOR: return (F("cursor"));
+    case SCROLL: return (F("scroll"));
+    case CUSTOM: return (F("custom"));
+    }
+    return (F("unknown"));
+  }
+
+protected:
+  /** Custom character bitmap; checker pattern. */
+  static const uint8_t BITMAP[8];
+
+  /**
+   * Run given workload once on given target. Returns false(0) if
+   * not supported by the target otherwise true(1).
+   * @param[in] ix workload.
+   * @param[in] target benchmark target.
+   * @return bool.
+   */
+  static bool workload(uint8_t ix, Target& target)
+  {
+    LCD::Device& lcd = *target.lcd;
+    switch (ix) {
+    case STRING:
+      lcd.cursor_set(0, 0);
+      lcd.print(F("Hello World"));
+      break;
+    case NUMBER:
+      lcd.cursor_set(0, 0);
+      lcd.print(INT32_MIN);
+      lcd.print(' ');
+      lcd.print(0x8000, HEX);
+      break;
+    case CLEAR:
+      lcd.display_clear();
+      break;
+    case FILL:
+      lcd.cursor_set(0, 0);
+      for (uint8_t y = 0; y < lcd.height(); y++)
+	for (uint8_t x = 0; x < lcd.width(); x++)
+	  lcd.write('A' + x);
+      break;
+    case CURSOR:
+      for (uint8_t y = 0; y < lcd.height(); y++) {
+	lcd.cursor_set(0, y);
+	lcd.cursor_set(lcd.width() - 1, y);
+      }
+      break;
+    case SCROLL:
+      lcd.cursor_set(0, lcd.height() - 1);
+      lcd.print(F("\nscroll"));
+      break;
+    case CUSTOM:
+      // Load and draw; character codes 0..7 are control characters
+      // for write() and are written to display memory directly
+      if (target.hd44780 == NULL) return (false);
+      {
+	uint8_t buf[8];
+	for (uint8_t id = 0; id < 8; id++) {
+	  target.hd44780->set_custom_char_P(id, BITMAP);
+	  buf[id] = id;
+	}
+	target.hd44780->ddram_write(0, 0, buf, sizeof(buf));
+      }
+      break;
+    }
+    return (true);
+  }
+
+  /**
+   * Print result record for given target and workload in the
+   * output format.
+   * @param[in] target benchmark target.
+   * @param[in] ix workload.
+   * @param[in] us time per workload.
+   * @param[in] bytes bus bytes per workload.
+   * @param[in] baseline baseline time per workload or zero.
+   * @param[in] delta change against baseline in percent.
+   * @param[in] status result status.
+   */
+  void report(Target& target, uint8_t ix,
+	      uint32_t us, uint32_t bytes,
+	      uint16_t baseline, int32_t delta,
+	      const __FlashStringHelper* status)
+  {
+    uint32_t ops = (us != 0 ? 1000000UL / us : 0);
+    switch (m_format) {
+    case CSV:
+      m_out.print(target.name);
+      m_out.print(',');
+      m_out.print(name(ix));
+      m_out.print(',');
+      m_out.print(us);
+      m_out.print(',');
+      m_out.print(ops);
+      m_out.print(',');
+      m_out.print(bytes);
+      m_out.print(',');
+      m_out.print(baseline);
+      m_out.print(',');
+      m_out.print(delta);
+      m_out.print(',');
+      m_out.println(status);
+      break;
+    case JSON:
+      m_out.print(F("{\"target\":\""));
+      m_out.print(target.name);
+      m_out.print(F("\",\"workload\":\""));
+      m_out.print(name(ix));
+      m_out.print(F("\",\"us\":"));
+      m_out.print(us);
+      m_out.print(F(",\"ops\":"));
+      m_out.print(ops);
+      m_out.print(F(",\"bytes\":"));
+      m_out.print(bytes);
+      m_out.print(F(",\"baseline\":"));
+      m_out.print(baseline);
+      m_out.print(F(",\"delta\":"));
+      m_out.print(delta);
+      m_out.print(F(",\"status\":\""));
+      m_out.print(status);
+      m_out.println(F("\"}"));
+      break;
+    case BASELINE:
+      m_out.print(' ');
+      m_out.print(us > 0xffffUL ? 0xffffUL : us);
+      if (ix < WORKLOAD_MAX - 1) m_out.print(',');
+      break;
+    }
+  }
+
+  Print& m_out;			//!< Output stream.
+  uint8_t m_format;		//!< Output format.
+  uint8_t m_threshold;		//!< Regression threshold (percent).
+  uint8_t m_repeat;		//!< Runs per workload.
+};
+
+const uint8_t Runner::BITMAP[8] PROGMEM = {
+  0b10101,
+  0b01010,
+  0b10101,
+  0b01010,
+  0b10101,
+  0b01010,
+  0b10101,
+  0b01010
+};
+};
+#endif
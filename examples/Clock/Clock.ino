@@ -47,10 +47,17 @@ HD44780 lcd(io);
 // DS1302<BOARD::D11, BOARD::D12, BOARD::D13> rtc;
 DS1307 rtc(twi);
 
+// Display fields; date and time. Only changed characters are written
+LCD::Field<10> date_field(0, 0, LCD::Device::Field::LEFT);
+LCD::Field<8> time_field(0, 1, LCD::Device::Field::LEFT);
+
 void setup()
 {
-  // Initiate display
+  // Initiate display and fields; single line display shows time field
   lcd.begin();
+  if (lcd.HEIGHT == 1) time_field.position(0, 0);
+  else lcd.attach(date_field);
+  lcd.attach(time_field);
 
   // Set the real-time clock
 #if defined(AVR)
@@ -69,26 +76,22 @@ void loop()
   char buf[32];
   isotime_r(&now, buf);
 
-  // Split datetime string and replace colon
+  // Split datetime string and update the fields
   buf[10] = 0;
   if (lcd.HEIGHT == 1) {
     static int n = 1;
-    lcd.cursor_home();
     if (n == 4) {
-      lcd.print(buf + 2);
+      lcd.update(time_field, buf + 2);
       n = 0;
     }
     else {
-      lcd.print(buf + 11);
+      lcd.update(time_field, buf + 11);
       n += 1;
     }
   }
   else {
-    lcd.cursor_home();
-    lcd.print(buf);
-    lcd.cursor_set(0, 1);
-    lcd.print(buf + 11);
+    lcd.update(date_field, buf);
+    lcd.update(time_field, buf + 11);
   }
   delay(1000);
-  lcd.display_clear();
 }
@@ -0,0 +1,295 @@
+/**
+ * @file Arduino.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include "Host.h"
+
+/**
+ * Host (Linux) subset of the Arduino core; program memory access,
+ * virtual time, pin access, Print and Serial on standard output.
+ */
+
+#define HIGH 0x1
+#define LOW  0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+#define LSBFIRST 0
+#define MSBFIRST 1
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define _BV(bit) (1 << (bit))
+
+// Program memory is ordinary memory
+#define PROGMEM
+#define PGM_P const char*
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t*) (addr))
+#define pgm_read_word(addr) (*(const uint16_t*) (addr))
+#define pgm_read_dword(addr) (*(const uint32_t*) (addr))
+#define pgm_read_ptr(addr) (*(void* const*) (addr))
+#define memcpy_P(dest, src, n) memcpy((dest), (src), (n))
+#define strlen_P(s) strlen(s)
+
+class __FlashStringHelper;
+#define F(s) ((const __FlashStringHelper*) PSTR(s))
+
+// Analog pins are mapped to the third port
+static const uint8_t A0 = 16;
+static const uint8_t A1 = 17;
+static const uint8_t A2 = 18;
+static const uint8_t A3 = 19;
+static const uint8_t A4 = 20;
+static const uint8_t A5 = 21;
+static const uint8_t SDA = A4;
+static const uint8_t SCL = A5;
+
+/**
+ * Return virtual time in micro-seconds. Each call advances time with
+ * Host::MICROS_COST.
+ * @return micro-seconds.
+ */
+inline uint32_t micros()
+{
+  Host::advance(Host::MICROS_COST);
+  return (Host::time);
+}
+
+/**
+ * Return virtual time in milli-seconds.
+ * @return milli-seconds.
+ */
+inline uint32_t millis()
+{
+  return (Host::time / 1000);
+}
+
+/**
+ * Advance virtual time with given number of milli-seconds.
+ * @param[in] ms milli-seconds.
+ */
+inline void delay(uint32_t ms)
+{
+  Host::advance(ms * 1000);
+}
+
+/**
+ * Advance virtual time with given number of micro-seconds.
+ * @param[in] us micro-seconds.
+ */
+inline void delayMicroseconds(unsigned int us)
+{
+  Host::advance(us);
+}
+
+inline void yield() {}
+inline void interrupts() {}
+inline void noInterrupts() {}
+
+inline void pinMode(uint8_t pin, uint8_t mode)
+{
+  if (mode == INPUT_PULLUP) Host::write(pin, HIGH);
+}
+
+inline void digitalWrite(uint8_t pin, uint8_t value)
+{
+  Host::write(pin, value);
+}
+
+inline int digitalRead(uint8_t pin)
+{
+  return (Host::read(pin));
+}
+
+inline int analogRead(uint8_t pin)
+{
+  if (pin >= A0) pin -= A0;
+  return (pin < Host::ANALOG_MAX ? Host::analog[pin] : 0);
+}
+
+/**
+ * Print class with the Arduino core print member functions.
+ */
+class Print {
+public:
+  virtual ~Print() {}
+
+  virtual size_t write(uint8_t c) = 0;
+
+  virtual size_t write(const uint8_t* buf, size_t size)
+  {
+    size_t n = 0;
+    while (size--) {
+      if (write(*buf++)) n++;
+      else break;
+    }
+    return (n);
+  }
+
+  size_t write(const char* str)
+  {
+    if (str == NULL) return (0);
+    return (write((const uint8_t*) str, strlen(str)));
+  }
+
+  size_t write(const char* buf, size_t size)
+  {
+    return (write((const uint8_t*) buf, size));
+  }
+
+  virtual void flush() {}
+
+  size_t print(const __FlashStringHelper* str)
+  {
+    return (write((const char*) str));
+  }
+
+  size_t print(const char str[])
+  {
+    return (write(str));
+  }
+
+  size_t print(char c)
+  {
+    return (write((uint8_t) c));
+  }
+
+  size_t print(unsigned char value, int base = DEC)
+  {
+    return (print((unsigned long) value, base));
+  }
+
+  size_t print(int value, int base = DEC)
+  {
+    return (print((long) value, base));
+  }
+
+  size_t print(unsigned int value, int base = DEC)
+  {
+    return (print((unsigned long) value, base));
+  }
+
+  size_t print(long value, int base = DEC)
+  {
+    if (base == DEC && value < 0) {
+      size_t n = print('-');
+      return (n + print_number(-(unsigned long) value, DEC));
+    }
+    return (print_number(value, base));
+  }
+
+  size_t print(unsigned long value, int base = DEC)
+  {
+    return (print_number(value, base));
+  }
+
+  size_t print(double value, int digits = 2)
+  {
+    return (print_float(value, digits));
+  }
+
+  size_t println()
+  {
+    return (write("\r\n"));
+  }
+
+  template<typename T> size_t println(T value)
+  {
+    size_t n = print(value);
+    return (n + println());
+  }
+
+  template<typename T> size_t println(T value, int base)
+  {
+    size_t n = print(value, base);
+    return (n + println());
+  }
+
+private:
+  size_t print_number(unsigned long value, uint8_t base)
+  {
+    char buf[8 * sizeof(long) + 1];
+    char* str = &buf[sizeof(buf) - 1];
+    *str = 0;
+    if (base < 2) base = DEC;
+    do {
+      char c = value % base;
+      value /= base;
+      *--str = c < 10 ? c + '0' : c + 'A' - 10;
+    } while (value != 0);
+    return (write(str));
+  }
+
+  size_t print_float(double value, uint8_t digits)
+  {
+    if (isnan(value)) return (print("nan"));
+    if (isinf(value)) return (print("inf"));
+    size_t n = 0;
+    if (value < 0.0) {
+      n += print('-');
+      value = -value;
+    }
+    double rounding = 0.5;
+    for (uint8_t i = 0; i < digits; i++) rounding /= 10.0;
+    value += rounding;
+    unsigned long integer = (unsigned long) value;
+    double remainder = value - (double) integer;
+    n += print(integer);
+    if (digits > 0) n += print('.');
+    while (digits-- > 0) {
+      remainder *= 10.0;
+      unsigned int digit = (unsigned int) remainder;
+      n += print(digit);
+      remainder -= digit;
+    }
+    return (n);
+  }
+};
+
+/**
+ * Serial on standard output.
+ */
+class HardwareSerial : public Print {
+public:
+  void begin(unsigned long baudrate) { (void) baudrate; }
+  void end() {}
+  int available() { return (0); }
+  int read() { return (-1); }
+  operator bool() { return (true); }
+  virtual size_t write(uint8_t c) { return (putchar(c) == EOF ? 0 : 1); }
+  virtual void flush() { fflush(stdout); }
+  using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+// Sketch functions
+extern void setup();
+extern void loop();
+#endif
@@ -0,0 +1,101 @@
+/**
+ * @file Driver/PCF8574.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef PCF8574_H
+#define PCF8574_H
+
+#include "../TWI.h"
+
+/**
+ * PCF8574 Remote 8-bit I/O expander device driver; same interface
+ * as the Arduino-TWI driver.
+ */
+class PCF8574 : protected TWI::Device {
+public:
+  /**
+   * Construct device driver with given bus and sub-address.
+   * @param[in] twi bus manager.
+   * @param[in] subaddr sub-address (0..7, default 7).
+   */
+  PCF8574(TWI& twi, uint8_t subaddr = 7) :
+    TWI::Device(twi, 0x20 | (subaddr & 0x07)),
+    m_ddr(0xff),
+    m_port(0)
+  {}
+
+  /**
+   * Set data direction; input pins set. Returns true(1) if
+   * successful otherwise false(0).
+   * @param[in] mask data direction (input) mask.
+   * @return bool.
+   */
+  bool ddr(uint8_t mask)
+  {
+    m_ddr = mask;
+    return (write(m_port));
+  }
+
+  /**
+   * Read port.
+   * @return port value.
+   */
+  uint8_t read()
+  {
+    uint8_t res = 0;
+    acquire();
+    TWI::Device::read(&res, sizeof(res));
+    release();
+    return (res & m_ddr);
+  }
+
+  /**
+   * Write given value to port. Input pins are kept high. Returns
+   * true(1) if successful otherwise false(0).
+   * @param[in] value port value.
+   * @return bool.
+   */
+  bool write(uint8_t value)
+  {
+    m_port = value & ~m_ddr;
+    uint8_t data = m_port | m_ddr;
+    acquire();
+    int res = TWI::Device::write(&data, sizeof(data));
+    release();
+    return (res == (int) sizeof(data));
+  }
+
+  /**
+   * Write given buffer of port values. Returns true(1) if successful
+   * otherwise false(0).
+   * @param[in] buf pointer to buffer.
+   * @param[in] size number of bytes.
+   * @return bool.
+   */
+  bool write(const void* buf, size_t size)
+  {
+    acquire();
+    int res = TWI::Device::write(buf, size);
+    release();
+    return (res == (int) size);
+  }
+
+protected:
+  uint8_t m_ddr;		//!< Data direction; input pins.
+  uint8_t m_port;		//!< Output port value.
+};
+#endif
@@ -0,0 +1,147 @@
+/**
+ * @file GPIO.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef GPIO_H
+#define GPIO_H
+
+#include "Arduino.h"
+
+/**
+ * Host pin numbering; three 8-bit ports with the Arduino Uno layout
+ * (D0..D7, D8..D13 and D14..D19/A0..A5).
+ */
+#define GPIO_PIN(port,bit) (((port) << 3) | (bit))
+#define GPIO_REG(pin) ((pin) >> 3)
+#define GPIO_MASK(pin) _BV((pin) & 0x07)
+
+class BOARD {
+public:
+  enum pin_t {
+    D0 = GPIO_PIN(0,0),
+    D1 = GPIO_PIN(0,1),
+    D2 = GPIO_PIN(0,2),
+    D3 = GPIO_PIN(0,3),
+    D4 = GPIO_PIN(0,4),
+    D5 = GPIO_PIN(0,5),
+    D6 = GPIO_PIN(0,6),
+    D7 = GPIO_PIN(0,7),
+    D8 = GPIO_PIN(1,0),
+    D9 = GPIO_PIN(1,1),
+    D10 = GPIO_PIN(1,2),
+    D11 = GPIO_PIN(1,3),
+    D12 = GPIO_PIN(1,4),
+    D13 = GPIO_PIN(1,5),
+    D14 = GPIO_PIN(2,0),
+    D15 = GPIO_PIN(2,1),
+    D16 = GPIO_PIN(2,2),
+    D17 = GPIO_PIN(2,3),
+    D18 = GPIO_PIN(2,4),
+    D19 = GPIO_PIN(2,5)
+  };
+};
+
+/**
+ * Host General Purpose Digital I/O pin template class. The pin
+ * state is kept in memory (Host::pin) and changes are logged as
+ * edges (Host::edge).
+ * @param[in] PIN board pin definition.
+ */
+template<BOARD::pin_t PIN>
+class GPIO {
+public:
+  /**
+   * Set pin to input mode.
+   */
+  void input() {}
+
+  /**
+   * Set pin to output mode.
+   */
+  void output() {}
+
+  /**
+   * Set pin to open drain mode; low level.
+   */
+  void open_drain()
+  {
+    low();
+  }
+
+  /**
+   * Return current pin state.
+   * @return state.
+   */
+  bool read() const
+  {
+    return (Host::read(PIN));
+  }
+
+  /**
+   * Set pin to given state.
+   * @param[in] value state.
+   */
+  void write(bool value)
+  {
+    Host::write(PIN, value);
+  }
+
+  /**
+   * Set pin high.
+   */
+  void high()
+  {
+    write(true);
+  }
+
+  /**
+   * Set pin low.
+   */
+  void low()
+  {
+    write(false);
+  }
+
+  /**
+   * Toggle pin state.
+   */
+  void toggle()
+  {
+    write(!read());
+  }
+
+  /**
+   * Set pin to given state.
+   * @param[in] value state.
+   * @return pin.
+   */
+  GPIO<PIN>& operator=(bool value)
+  {
+    write(value);
+    return (*this);
+  }
+
+  /**
+   * Return current pin state.
+   * @return state.
+   */
+  operator bool() const
+  {
+    return (read());
+  }
+};
+#endif
@@ -0,0 +1,290 @@
+/**
+ * @file HD44780_Model.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef HOST_HD44780_MODEL_H
+#define HOST_HD44780_MODEL_H
+
+#include "Arduino.h"
+
+namespace Host {
+/**
+ * HD44780 controller model for host tests. Decodes the 4-bit
+ * interface (register select and data nibble on the falling enable
+ * edge) into display data (DDRAM) and custom character (CGRAM)
+ * memory. Instructions are checked against the execution time of
+ * the previous instruction; violations are counted.
+ *
+ * The interface may be sampled from the pin edge log, see
+ * pins() and poll(), or from a PCF8574 model, see attach().
+ */
+class HD44780_Model {
+public:
+  /** Execution time of clear display and return home (us). */
+  static const uint32_t LONG_EXEC_TIME = 1520;
+
+  /** Execution time of other instructions and data writes (us). */
+  static const uint32_t SHORT_EXEC_TIME = 37;
+
+  /**
+   * Construct controller model in power on reset state.
+   */
+  HD44780_Model() :
+    m_d0(0),
+    m_rs(0),
+    m_en(0),
+    m_edge(0),
+    m_en_bit(0),
+    m_rs_bit(0),
+    m_data_shift(0),
+    m_port(0)
+  {
+    reset();
+  }
+
+  /**
+   * Reset controller; power on reset state with 8-bit interface,
+   * cleared display and increment entry mode.
+   */
+  void reset()
+  {
+    memset(ddram, ' ', sizeof(ddram));
+    memset(cgram, 0, sizeof(cgram));
+    ac = 0;
+    cgram_mode = false;
+    increment = true;
+    display_on = false;
+    cursor_on = false;
+    blink_on = false;
+    shift = 0;
+    two_lines = false;
+    bits8 = true;
+    violations = 0;
+    overruns = 0;
+    instructions = 0;
+    m_half = false;
+    m_start = 0;
+    m_exec = 0;
+  }
+
+  /**
+   * Sample the interface from the pin edge log with the given pins.
+   * The data pins are d0..d0+3. Edges logged after this call are
+   * decoded by poll().
+   * @param[in] d0 first data pin (D4 on the display).
+   * @param[in] rs register select pin.
+   * @param[in] en enable pin.
+   */
+  void pins(uint8_t d0, uint8_t rs, uint8_t en)
+  {
+    m_d0 = d0;
+    m_rs = rs;
+    m_en = en;
+    m_edge = Host::edges;
+    memcpy(m_pin, Host::pin, sizeof(m_pin));
+  }
+
+  /**
+   * Decode the edges logged since the last call. Edges that have
+   * been overwritten in the log are counted as overruns.
+   */
+  void poll()
+  {
+    if (Host::edges - m_edge > EDGE_MAX) {
+      overruns += 1;
+      m_edge = Host::edges - EDGE_MAX;
+    }
+    for (; m_edge != Host::edges; m_edge++) {
+      const edge_t& e = edge[m_edge % EDGE_MAX];
+      m_pin[e.pin] = e.value;
+      if (e.pin != m_en || e.value != 0) continue;
+      uint8_t data = 0;
+      for (uint8_t i = 0; i < 4; i++)
+	if (m_pin[m_d0 + i]) data |= (1 << i);
+      clock(m_pin[m_rs], data, e.time);
+    }
+  }
+
+  /**
+   * Sample the interface from the given PCF8574 model with the given
+   * port bit layout. Each port write is decoded directly.
+   * @param[in] dev expander model.
+   * @param[in] data_shift position of data nibble (D4 on display).
+   * @param[in] rs_bit register select bit.
+   * @param[in] en_bit enable bit.
+   */
+  void attach(PCF8574& dev, uint8_t data_shift, uint8_t rs_bit, uint8_t en_bit)
+  {
+    m_data_shift = data_shift;
+    m_rs_bit = rs_bit;
+    m_en_bit = en_bit;
+    m_port = dev.latch;
+    dev.callback = port_write;
+    dev.env = this;
+  }
+
+  /**
+   * Clock given register select and data nibble at given time.
+   * @param[in] rs register select; zero(0) instruction, data otherwise.
+   * @param[in] data nibble.
+   * @param[in] time virtual time (us).
+   */
+  void clock(bool rs, uint8_t data, uint32_t time)
+  {
+    if (bits8) {
+      execute(rs, data << 4, time);
+      return;
+    }
+    if (!m_half) {
+      if ((uint32_t) (time - m_start) < m_exec) violations += 1;
+      m_data = data << 4;
+      m_half = true;
+      return;
+    }
+    m_half = false;
+    execute(rs, m_data | (data & 0x0f), time);
+  }
+
+  /**
+   * Copy the given number of characters from display data memory at
+   * given address to the given buffer and terminate with a null.
+   * Returns the buffer.
+   * @param[in] buf destination buffer.
+   * @param[in] addr display data address.
+   * @param[in] n number of characters.
+   * @return buffer.
+   */
+  char* text(char* buf, uint8_t addr, uint8_t n) const
+  {
+    for (uint8_t i = 0; i < n; i++)
+      buf[i] = ddram[(addr + i) & 0x7f];
+    buf[n] = 0;
+    return (buf);
+  }
+
+  uint8_t ddram[128];		//!< Display data memory.
+  uint8_t cgram[64];		//!< Custom character memory.
+  uint8_t ac;			//!< Address counter.
+  bool cgram_mode;		//!< Address counter in CGRAM.
+  bool increment;		//!< Entry mode increment.
+  bool display_on;		//!< Display on.
+  bool cursor_on;		//!< Underline cursor on.
+  bool blink_on;		//!< Blink cursor on.
+  int8_t shift;			//!< Display shift (right positive).
+  bool two_lines;		//!< Two line display mode.
+  bool bits8;			//!< 8-bit interface.
+  uint32_t violations;		//!< Instructions during execution time.
+  uint32_t overruns;		//!< Edge log overruns.
+  uint32_t instructions;	//!< Number of instructions and data writes.
+
+protected:
+  /**
+   * PCF8574 model port write callback; decode enable falling edge.
+   * @param[in] port new port value.
+   * @param[in] env model.
+   */
+  static void port_write(uint8_t port, void* env)
+  {
+    HD44780_Model* model = (HD44780_Model*) env;
+    uint8_t en = _BV(model->m_en_bit);
+    if ((model->m_port & en) && !(port & en))
+      model->clock((port >> model->m_rs_bit) & 1,
+		   (port >> model->m_data_shift) & 0x0f,
+		   Host::time);
+    model->m_port = port;
+  }
+
+  /**
+   * Execute given instruction or data write at given time.
+   * @param[in] rs register select.
+   * @param[in] data instruction or data.
+   * @param[in] time virtual time (us).
+   */
+  void execute(bool rs, uint8_t data, uint32_t time)
+  {
+    uint32_t us = SHORT_EXEC_TIME;
+    instructions += 1;
+    if (rs) {
+      if (cgram_mode) cgram[ac & 0x3f] = data;
+      else ddram[ac & 0x7f] = data;
+      ac += (increment ? 1 : -1);
+      // Two line mode; second line continues at the first line
+      if (!cgram_mode && two_lines) {
+	if (ac == 0x28) ac = 0x40;
+	else if (ac == 0x68) ac = 0x00;
+      }
+    }
+    else if (data & 0x80) {
+      ac = data & 0x7f;
+      cgram_mode = false;
+    }
+    else if (data & 0x40) {
+      ac = data & 0x3f;
+      cgram_mode = true;
+    }
+    else if (data & 0x20) {
+      bits8 = (data & 0x10) != 0;
+      two_lines = (data & 0x08) != 0;
+      m_half = false;
+    }
+    else if (data & 0x10) {
+      int8_t dir = ((data & 0x04) ? 1 : -1);
+      if (data & 0x08) shift += dir;
+      else ac += dir;
+    }
+    else if (data & 0x08) {
+      display_on = (data & 0x04) != 0;
+      cursor_on = (data & 0x02) != 0;
+      blink_on = (data & 0x01) != 0;
+    }
+    else if (data & 0x04) {
+      increment = (data & 0x02) != 0;
+    }
+    else if (data & 0x02) {
+      ac = 0;
+      shift = 0;
+      cgram_mode = false;
+      us = LONG_EXEC_TIME;
+    }
+    else if (data & 0x01) {
+      memset(ddram, ' ', sizeof(ddram));
+      ac = 0;
+      shift = 0;
+      cgram_mode = false;
+      increment = true;
+      us = LONG_EXEC_TIME;
+    }
+    m_start = time;
+    m_exec = us;
+  }
+
+  uint8_t m_d0;			//!< First data pin.
+  uint8_t m_rs;			//!< Register select pin.
+  uint8_t m_en;			//!< Enable pin.
+  uint32_t m_edge;		//!< Next edge to decode.
+  uint8_t m_pin[PIN_MAX];	//!< Pin state at next edge.
+  uint8_t m_en_bit;		//!< Expander enable bit.
+  uint8_t m_rs_bit;		//!< Expander register select bit.
+  uint8_t m_data_shift;		//!< Expander data nibble position.
+  uint8_t m_port;		//!< Expander port value.
+  bool m_half;			//!< High nibble received.
+  uint8_t m_data;		//!< High nibble.
+  uint32_t m_start;		//!< Start of execution (us).
+  uint32_t m_exec;		//!< Execution time (us).
+};
+};
+#endif
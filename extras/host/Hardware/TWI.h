@@ -0,0 +1,37 @@
+/**
+ * @file Hardware/TWI.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef HARDWARE_TWI_H
+#define HARDWARE_TWI_H
+
+#include "../TWI.h"
+
+namespace Hardware {
+/**
+ * Host hardware TWI bus; see Host::TWI.
+ */
+class TWI : public Host::TWI {
+public:
+  /**
+   * Construct hardware bus with given frequency.
+   * @param[in] freq bus frequency (Default 100 kHz).
+   */
+  TWI(uint32_t freq = 100000UL) : Host::TWI(freq) {}
+};
+};
+#endif
@@ -0,0 +1,61 @@
+/**
+ * @file Headers.cpp
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+// Compile all library headers for the host
+#include "GPIO.h"
+#include "TWI.h"
+#include "Hardware/TWI.h"
+#include "Software/TWI.h"
+#include "LCD.h"
+#include "Driver/HD44780.h"
+#include "Driver/MAX72XX.h"
+#include "Driver/PCD8544.h"
+#include "Device/Canvas.h"
+#include "Device/Group.h"
+#include "Device/Mirror.h"
+#include "Adapter/Debug.h"
+#include "Adapter/DFRobot_IIC.h"
+#include "Adapter/GY_IICLCD.h"
+#include "Adapter/MCP23008.h"
+#include "Adapter/MCP23017.h"
+#include "Adapter/MJKDZ.h"
+#include "Adapter/PCF8574_Adapter.h"
+#include "Adapter/PP7W.h"
+#include "Adapter/SR3W.h"
+#include "Adapter/SR3W_SPI.h"
+#include "Adapter/SR4W.h"
+#include "Adapter/SR4W_SPI.h"
+#include "Adapter/TWI_Async.h"
+#include "Adapter/TWI_Scheduler.h"
+#include "Shield/LCD4884.h"
+#include "Shield/LCD_Keypad.h"
+#include "Widget/Bar.h"
+#include "Widget/BigNumber.h"
+#include "Widget/Marquee.h"
+#include "Widget/Sparkline.h"
+
+// Instantiate the adapter and driver templates
+template class LCD::PP7W<BOARD::D4, BOARD::D5, BOARD::D6, BOARD::D7,
+			 BOARD::D8, BOARD::D9, BOARD::D10>;
+template class LCD::SR3W<BOARD::D7, BOARD::D6, BOARD::D5>;
+template class LCD::SR4W<BOARD::D7, BOARD::D6, BOARD::D5, BOARD::D4>;
+template class LCD::SR3W_SPI<BOARD::D10>;
+template class LCD::SR4W_SPI<BOARD::D10, BOARD::D9, BOARD::D8>;
+template class MAX72XX<BOARD::D10, BOARD::D11, BOARD::D13>;
+template class PCD8544<BOARD::D5, BOARD::D4, BOARD::D3, BOARD::D2>;
+template class LCD::Scheduled<LCD::MJKDZ>;
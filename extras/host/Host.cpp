@@ -0,0 +1,36 @@
+/**
+ * @file Host.cpp
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#include "Arduino.h"
+#include "SPI.h"
+
+namespace Host {
+uint32_t time = 0;
+uint8_t pin[PIN_MAX];
+uint16_t analog[ANALOG_MAX] = { 1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023 };
+edge_t edge[EDGE_MAX];
+uint32_t edges = 0;
+FILE* trace = NULL;
+capture_t spi;
+capture_t srpo;
+PCF8574 pcf8574[16];
+Model* model[128];
+};
+
+HardwareSerial Serial;
+SPIClass SPI;
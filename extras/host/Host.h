@@ -0,0 +1,277 @@
+/**
+ * @file Host.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef HOST_H
+#define HOST_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * Host (Linux) hardware abstraction layer state. Allows the library
+ * and sketches to be built and run natively; pins are in-memory
+ * state with an edge log, SPI and shift register output is captured,
+ * TWI devices are memory-backed PCF8574 models and time is virtual.
+ * The state is available to tests and tools through this namespace.
+ */
+namespace Host {
+
+/** Number of pins (three 8-bit ports). */
+const uint8_t PIN_MAX = 24;
+
+/** Number of analog pins. */
+const uint8_t ANALOG_MAX = 8;
+
+/**
+ * Virtual time cost of a call to micros() (us). Gives the resolution
+ * of the AVR timer and allows busy-wait loops to terminate.
+ */
+const uint32_t MICROS_COST = 4;
+
+/**
+ * Capture buffer; keeps the last CAPTURE_MAX bytes and a total
+ * count.
+ */
+struct capture_t {
+  static const size_t CAPTURE_MAX = 1024;
+  uint8_t buf[CAPTURE_MAX];	//!< Last captured bytes.
+  uint32_t count;		//!< Total number of bytes.
+
+  /**
+   * Append given byte.
+   * @param[in] value byte.
+   */
+  void put(uint8_t value)
+  {
+    buf[count % CAPTURE_MAX] = value;
+    count += 1;
+  }
+
+  /**
+   * Return given captured byte, counted from the most recent (0).
+   * @param[in] ix index.
+   * @return byte.
+   */
+  uint8_t last(uint32_t ix = 0) const
+  {
+    return (buf[(count - 1 - ix) % CAPTURE_MAX]);
+  }
+
+  /**
+   * Reset capture buffer.
+   */
+  void reset()
+  {
+    count = 0;
+  }
+};
+
+/**
+ * Pin edge log record.
+ */
+struct edge_t {
+  uint32_t time;		//!< Virtual time (us).
+  uint8_t pin;			//!< Pin number.
+  uint8_t value;		//!< New pin value.
+};
+
+/** Number of records in the edge log. */
+const size_t EDGE_MAX = 4096;
+
+/** Virtual time (us). */
+extern uint32_t time;
+
+/** Pin state. */
+extern uint8_t pin[PIN_MAX];
+
+/** Analog pin values (0..1023). */
+extern uint16_t analog[ANALOG_MAX];
+
+/** Edge log; ring buffer of the last EDGE_MAX edges. */
+extern edge_t edge[EDGE_MAX];
+
+/** Total number of edges. */
+extern uint32_t edges;
+
+/** Edge trace output or NULL. */
+extern FILE* trace;
+
+/** SPI transfer capture. */
+extern capture_t spi;
+
+/** Shift register (SRPO) output capture. */
+extern capture_t srpo;
+
+/**
+ * Advance virtual time with given number of micro-seconds.
+ * @param[in] us micro-seconds.
+ */
+inline void advance(uint32_t us)
+{
+  time += us;
+}
+
+/**
+ * Set given pin to given value. Changes are logged as edges.
+ * @param[in] nr pin number.
+ * @param[in] value pin value.
+ */
+inline void write(uint8_t nr, bool value)
+{
+  if (nr >= PIN_MAX || pin[nr] == value) return;
+  pin[nr] = value;
+  edge_t& e = edge[edges % EDGE_MAX];
+  e.time = time;
+  e.pin = nr;
+  e.value = value;
+  edges += 1;
+  if (trace != NULL) fprintf(trace, "%lu: pin %u = %u\n", (unsigned long) time, nr, value);
+}
+
+/**
+ * Return value of given pin.
+ * @param[in] nr pin number.
+ * @return pin value.
+ */
+inline bool read(uint8_t nr)
+{
+  return (nr < PIN_MAX ? pin[nr] : 0);
+}
+
+/**
+ * TWI device model. Attached to the host bus at a device address.
+ */
+class Model {
+public:
+  /**
+   * Read given number of bytes into given buffer. Returns number of
+   * bytes or negative error code.
+   * @param[in] buf pointer to buffer.
+   * @param[in] count number of bytes.
+   * @return number of bytes or negative error code.
+   */
+  virtual int read(void* buf, size_t count) = 0;
+
+  /**
+   * Write given buffer. Returns number of bytes or negative error
+   * code.
+   * @param[in] buf pointer to buffer.
+   * @param[in] count number of bytes.
+   * @return number of bytes or negative error code.
+   */
+  virtual int write(const void* buf, size_t count) = 0;
+};
+
+/**
+ * Memory-backed PCF8574 remote 8-bit I/O expander model. Each byte
+ * written sets the port latch. Read returns the latch and the input
+ * pins; quasi-bidirectional pins read low when driven low on either
+ * side. An optional callback is called on each port write.
+ */
+class PCF8574 : public Model {
+public:
+  /** Port write callback. */
+  typedef void (*callback_t)(uint8_t port, void* env);
+
+  /**
+   * Construct expander model with latch and input pins high.
+   */
+  PCF8574() :
+    latch(0xff),
+    input(0xff),
+    writes(0),
+    reads(0),
+    callback(NULL),
+    env(NULL)
+  {}
+
+  /**
+   * @override{Host::Model}
+   * Read port.
+   * @param[in] buf pointer to buffer.
+   * @param[in] count number of bytes.
+   * @return number of bytes.
+   */
+  virtual int read(void* buf, size_t count)
+  {
+    uint8_t* bp = (uint8_t*) buf;
+    for (size_t i = 0; i < count; i++) bp[i] = latch & input;
+    reads += count;
+    return (count);
+  }
+
+  /**
+   * @override{Host::Model}
+   * Write port latch, one byte at a time.
+   * @param[in] buf pointer to buffer.
+   * @param[in] count number of bytes.
+   * @return number of bytes.
+   */
+  virtual int write(const void* buf, size_t count)
+  {
+    const uint8_t* bp = (const uint8_t*) buf;
+    for (size_t i = 0; i < count; i++) {
+      latch = bp[i];
+      if (callback != NULL) callback(latch, env);
+    }
+    writes += count;
+    return (count);
+  }
+
+  uint8_t latch;		//!< Port latch.
+  uint8_t input;		//!< Input pin levels.
+  uint32_t writes;		//!< Number of bytes written.
+  uint32_t reads;		//!< Number of bytes read.
+  callback_t callback;		//!< Port write callback or NULL.
+  void* env;			//!< Callback environment.
+};
+
+/** PCF8574 models for the default addresses (0x20..0x27, 0x38..0x3f). */
+extern PCF8574 pcf8574[16];
+
+/** Attached TWI device models; by address. */
+extern Model* model[128];
+
+/**
+ * Attach given model to given device address.
+ * @param[in] addr device address.
+ * @param[in] dev model or NULL to detach.
+ */
+inline void attach(uint8_t addr, Model* dev)
+{
+  model[addr & 0x7f] = dev;
+}
+
+/**
+ * Return device model for given address. Addresses without an
+ * attached model in the PCF8574 ranges use the default expander
+ * models. Returns NULL if no device (not acknowledged).
+ * @param[in] addr device address.
+ * @return model or NULL.
+ */
+inline Model* lookup(uint8_t addr)
+{
+  addr &= 0x7f;
+  if (model[addr] != NULL) return (model[addr]);
+  if ((addr & 0x78) == 0x20) return (&pcf8574[addr & 0x07]);
+  if ((addr & 0x78) == 0x38) return (&pcf8574[8 + (addr & 0x07)]);
+  return (NULL);
+}
+};
+#endif
@@ -0,0 +1,82 @@
+/**
+ * @file Keypad.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef KEYPAD_H
+#define KEYPAD_H
+
+#include "Arduino.h"
+
+/**
+ * Host analog keypad. The key is given by the analog pin value
+ * (Host::analog) and the key map; program memory vector of
+ * thresholds in descent order. Key zero is no key.
+ * @param[in] PIN analog pin.
+ */
+template<uint8_t PIN>
+class Keypad {
+public:
+  /**
+   * Construct keypad with given key map.
+   * @param[in] map key map in program memory.
+   */
+  Keypad(const uint16_t* map) :
+    m_map(map),
+    m_key(0),
+    m_timestamp(0)
+  {}
+
+  /**
+   * Sample the analog pin and return true(1) if the key has changed
+   * otherwise false(0).
+   * @return bool.
+   */
+  bool ischanged()
+  {
+    uint16_t value = analogRead(PIN);
+    uint8_t key = 0;
+    while (key < 16 && value < pgm_read_word(&m_map[key])) key++;
+    if (key == m_key) return (false);
+    m_key = key;
+    m_timestamp = millis();
+    return (true);
+  }
+
+  /**
+   * Return current key.
+   * @return key.
+   */
+  uint8_t key() const
+  {
+    return (m_key);
+  }
+
+  /**
+   * Return time of last key change (ms).
+   * @return milli-seconds.
+   */
+  uint32_t timestamp() const
+  {
+    return (m_timestamp);
+  }
+
+protected:
+  const uint16_t* m_map;	//!< Key map in program memory.
+  uint8_t m_key;		//!< Current key.
+  uint32_t m_timestamp;		//!< Time of last key change.
+};
+#endif
@@ -0,0 +1,77 @@
+/**
+ * @file SPI.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef SPI_H
+#define SPI_H
+
+#include "Arduino.h"
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0c
+
+/**
+ * Host SPI settings; ignored.
+ */
+class SPISettings {
+public:
+  SPISettings(uint32_t clock = 4000000UL,
+	      uint8_t order = MSBFIRST,
+	      uint8_t mode = SPI_MODE0) :
+    m_clock(clock)
+  {
+    (void) order;
+    (void) mode;
+  }
+
+  uint32_t m_clock;		//!< Clock frequency (Hz).
+};
+
+/**
+ * Host SPI bus. Transferred bytes are captured (Host::spi) and
+ * virtual time is advanced with the transfer time at the
+ * transaction clock frequency.
+ */
+class SPIClass {
+public:
+  SPIClass() : m_clock(4000000UL) {}
+
+  void begin() {}
+  void end() {}
+
+  void beginTransaction(SPISettings settings)
+  {
+    m_clock = settings.m_clock;
+  }
+
+  void endTransaction() {}
+
+  uint8_t transfer(uint8_t value)
+  {
+    Host::spi.put(value);
+    Host::advance(8000000UL / m_clock);
+    return (0);
+  }
+
+protected:
+  uint32_t m_clock;		//!< Clock frequency (Hz).
+};
+
+extern SPIClass SPI;
+#endif
@@ -0,0 +1,69 @@
+/**
+ * @file SRPO.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef SRPO_H
+#define SRPO_H
+
+#include "GPIO.h"
+
+/**
+ * Host Shift Register Parallel Output template class. Bits are
+ * shifted out on the data and clock pins (edge log) and the bytes
+ * are captured (Host::srpo).
+ * @param[in] BITORDER LSBFIRST or MSBFIRST.
+ * @param[in] DATA_PIN board pin for data output signal.
+ * @param[in] CLOCK_PIN board pin for clock output signal.
+ */
+template<uint8_t BITORDER, BOARD::pin_t DATA_PIN, BOARD::pin_t CLOCK_PIN>
+class SRPO {
+public:
+  /**
+   * Initiate data and clock pins.
+   */
+  SRPO()
+  {
+    m_data.output();
+    m_clock.output();
+  }
+
+  /**
+   * Shift out given byte.
+   * @param[in] value to write.
+   */
+  void write(uint8_t value)
+  {
+    Host::srpo.put(value);
+    for (uint8_t i = 0; i < 8; i++) {
+      if (BITORDER == MSBFIRST) {
+	m_data = value & 0x80;
+	value <<= 1;
+      }
+      else {
+	m_data = value & 0x01;
+	value >>= 1;
+      }
+      m_clock.toggle();
+      m_clock.toggle();
+    }
+  }
+
+protected:
+  GPIO<DATA_PIN> m_data;	//!< Data output pin.
+  GPIO<CLOCK_PIN> m_clock;	//!< Clock output pin.
+};
+#endif
@@ -0,0 +1,49 @@
+/**
+ * @file Software/TWI.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef SOFTWARE_TWI_H
+#define SOFTWARE_TWI_H
+
+#include "../TWI.h"
+#include "GPIO.h"
+
+namespace Software {
+/**
+ * Host software TWI bus; see Host::TWI. The bus pins are kept high
+ * and the bus frequency is approximately 100 kHz.
+ * @param[in] SDA_PIN board pin for data signal.
+ * @param[in] SCL_PIN board pin for clock signal.
+ */
+template<BOARD::pin_t SDA_PIN, BOARD::pin_t SCL_PIN>
+class TWI : public Host::TWI {
+public:
+  /**
+   * Construct software bus.
+   */
+  TWI() : Host::TWI(100000UL)
+  {
+    m_sda.high();
+    m_scl.high();
+  }
+
+protected:
+  GPIO<SDA_PIN> m_sda;		//!< Data signal.
+  GPIO<SCL_PIN> m_scl;		//!< Clock signal.
+};
+};
+#endif
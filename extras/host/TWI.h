@@ -0,0 +1,200 @@
+/**
+ * @file TWI.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef TWI_H
+#define TWI_H
+
+#include "Arduino.h"
+
+/**
+ * Host Two-Wire Interface bus manager abstract interface; same
+ * interface as Arduino-TWI.
+ */
+class TWI {
+public:
+  /**
+   * Device driver support; device address and bus access.
+   */
+  class Device {
+  public:
+    /**
+     * Construct device driver for given bus and device address.
+     * @param[in] twi bus manager.
+     * @param[in] addr device address.
+     */
+    Device(TWI& twi, uint8_t addr) :
+      m_twi(twi),
+      m_addr(addr)
+    {}
+
+  protected:
+    /**
+     * Acquire bus access.
+     */
+    void acquire()
+    {
+      m_twi.acquire();
+    }
+
+    /**
+     * Release bus access.
+     */
+    void release()
+    {
+      m_twi.release();
+    }
+
+    /**
+     * Read into given buffer from device. Returns number of bytes
+     * or negative error code.
+     * @param[in] buf pointer to buffer.
+     * @param[in] count number of bytes.
+     * @return number of bytes or negative error code.
+     */
+    int read(void* buf, size_t count)
+    {
+      return (m_twi.read(m_addr, buf, count));
+    }
+
+    /**
+     * Write given buffer to device. Returns number of bytes or
+     * negative error code.
+     * @param[in] buf pointer to buffer.
+     * @param[in] count number of bytes.
+     * @return number of bytes or negative error code.
+     */
+    int write(const void* buf, size_t count)
+    {
+      return (m_twi.write(m_addr, buf, count));
+    }
+
+    TWI& m_twi;			//!< Bus manager.
+    uint8_t m_addr;		//!< Device address.
+  };
+
+  /**
+   * Construct bus manager.
+   */
+  TWI() : m_busy(false) {}
+
+  virtual ~TWI() {}
+
+  /**
+   * Acquire bus access.
+   */
+  void acquire()
+  {
+    m_busy = true;
+  }
+
+  /**
+   * Release bus access.
+   */
+  void release()
+  {
+    m_busy = false;
+  }
+
+  /**
+   * Read given number of bytes from device with given address.
+   * @param[in] addr device address.
+   * @param[in] buf pointer to buffer.
+   * @param[in] count number of bytes.
+   * @return number of bytes or negative error code.
+   */
+  virtual int read(uint8_t addr, void* buf, size_t count) = 0;
+
+  /**
+   * Write given buffer to device with given address.
+   * @param[in] addr device address.
+   * @param[in] buf pointer to buffer.
+   * @param[in] count number of bytes.
+   * @return number of bytes or negative error code.
+   */
+  virtual int write(uint8_t addr, const void* buf, size_t count) = 0;
+
+protected:
+  bool m_busy;			//!< Bus acquired.
+};
+
+namespace Host {
+/**
+ * Host TWI bus; transfers to the device models (Host::lookup) and
+ * advances virtual time with the transfer time; start, address,
+ * data and stop at the given bus frequency. Written bytes are passed
+ * to the device model one at a time at the end of each byte time.
+ */
+class TWI : public ::TWI {
+public:
+  /**
+   * Construct host bus with given frequency.
+   * @param[in] freq bus frequency (Hz).
+   */
+  TWI(uint32_t freq) :
+    ::TWI(),
+    m_freq(freq)
+  {}
+
+  /**
+   * @override{TWI}
+   * Read from device model.
+   * @param[in] addr device address.
+   * @param[in] buf pointer to buffer.
+   * @param[in] count number of bytes.
+   * @return number of bytes or negative error code.
+   */
+  virtual int read(uint8_t addr, void* buf, size_t count)
+  {
+    Model* dev = lookup(addr);
+    advance(((count + 1) * 9 + 2) * 1000000UL / m_freq);
+    if (dev == NULL) return (-1);
+    return (dev->read(buf, count));
+  }
+
+  /**
+   * @override{TWI}
+   * Write to device model.
+   * @param[in] addr device address.
+   * @param[in] buf pointer to buffer.
+   * @param[in] count number of bytes.
+   * @return number of bytes or negative error code.
+   */
+  virtual int write(uint8_t addr, const void* buf, size_t count)
+  {
+    Model* dev = lookup(addr);
+    uint32_t start = time;
+    if (dev == NULL) {
+      advance(((count + 1) * 9 + 2) * 1000000UL / m_freq);
+      return (-1);
+    }
+    const uint8_t* bp = (const uint8_t*) buf;
+    uint32_t bits = 10;
+    for (size_t i = 0; i < count; i++) {
+      bits += 9;
+      time = start + bits * 1000000UL / m_freq;
+      dev->write(bp++, 1);
+    }
+    time = start + (bits + 1) * 1000000UL / m_freq;
+    return (count);
+  }
+
+protected:
+  uint32_t m_freq;		//!< Bus frequency (Hz).
+};
+};
+#endif
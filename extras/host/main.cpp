@@ -0,0 +1,34 @@
+/**
+ * @file main.cpp
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#include "Arduino.h"
+
+/**
+ * Run sketch; setup() and the given number of calls to loop()
+ * (Default 1). Pin edges are traced on standard error when the
+ * environment variable HOST_TRACE is set.
+ */
+int main(int argc, char* argv[])
+{
+  unsigned long count = (argc > 1 ? strtoul(argv[1], NULL, 0) : 1);
+  if (getenv("HOST_TRACE") != NULL) Host::trace = stderr;
+  setup();
+  for (unsigned long i = 0; i < count; i++) loop();
+  Serial.flush();
+  return (0);
+}
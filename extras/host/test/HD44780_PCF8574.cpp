@@ -0,0 +1,76 @@
+/**
+ * @file test/HD44780_PCF8574.cpp
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#include "Test.h"
+#include "TWI.h"
+#include "Hardware/TWI.h"
+#include "LCD.h"
+#include "Driver/HD44780.h"
+#include "Adapter/MJKDZ.h"
+#include "Adapter/DFRobot_IIC.h"
+
+// HD44780 16x2 on MJKDZ and DFRobot PCF8574 boards on a 400 kHz
+// bus; the expander port writes are decoded to display data memory
+
+Hardware::TWI twi(400000UL);
+LCD::MJKDZ mjkdz(twi, 7);
+LCD::DFRobot_IIC dfrobot(twi, 6);
+HD44780 lcd0(mjkdz);
+HD44780 lcd1(dfrobot);
+Host::HD44780_Model model0;
+Host::HD44780_Model model1;
+
+void test()
+{
+  // MJKDZ: data P0..P3, EN P4, RS P6; DFRobot: RS P0, EN P2, data P4..P7
+  model0.attach(Host::pcf8574[7], 0, 6, 4);
+  model1.attach(Host::pcf8574[6], 4, 0, 2);
+
+  lcd0.begin();
+  lcd1.begin();
+  CHECK(!model0.bits8 && model0.two_lines && model0.display_on);
+  CHECK(!model1.bits8 && model1.two_lines && model1.display_on);
+
+  // Character and buffer (batched) writes
+  lcd0.print(F("MJKDZ"));
+  lcd0.cursor_set(0, 1);
+  lcd0.print(0x1234, HEX);
+  lcd1.print(F("DFRobot IIC"));
+  lcd1.cursor_set(4, 1);
+  lcd1.print(42);
+  CHECK_TEXT(model0, 0x00, "MJKDZ           ");
+  CHECK_TEXT(model0, 0x40, "1234            ");
+  CHECK_TEXT(model1, 0x00, "DFRobot IIC     ");
+  CHECK_TEXT(model1, 0x40, "    42          ");
+
+  // Line wrap and clear
+  lcd0.cursor_set(0, 0);
+  lcd0.print(F("0123456789ABCDEFwrap"));
+  CHECK_TEXT(model0, 0x00, "0123456789ABCDEF");
+  CHECK_TEXT(model0, 0x40, "wrap            ");
+  lcd1.display_clear();
+  lcd1.print(F("cleared"));
+  CHECK_TEXT(model1, 0x00, "cleared         ");
+  CHECK_TEXT(model1, 0x40, "                ");
+
+  // No instruction within the execution time
+  CHECK(model0.violations == 0);
+  CHECK(model1.violations == 0);
+}
+
+TEST_MAIN(test)
@@ -0,0 +1,235 @@
+/**
+ * @file test/HD44780_PP7W.cpp
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#include "Test.h"
+#include "GPIO.h"
+#include "LCD.h"
+#include "Driver/HD44780.h"
+#include "Adapter/PP7W.h"
+#include "Widget/BigNumber.h"
+#include "Widget/Marquee.h"
+
+// HD44780 20x4 on the 7-wire parallel port; the pin edge log is
+// decoded to display data and custom character memory
+
+LCD::PP7W<BOARD::D4, BOARD::D5, BOARD::D6, BOARD::D7,
+	  BOARD::D8, BOARD::D9, BOARD::D10> io;
+HD44780 lcd(io, 20, 4);
+Host::HD44780_Model model;
+
+// Row addresses of 20x4 display
+const uint8_t ROW[] = { 0x00, 0x40, 0x14, 0x54 };
+
+const uint8_t BITMAP[8] = {
+  0x01, 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02
+};
+
+void test()
+{
+  model.pins(BOARD::D4, BOARD::D8, BOARD::D9);
+
+  // Start sequence; 4-bit mode, two line mode, display on
+  lcd.begin();
+  model.poll();
+  CHECK(!model.bits8);
+  CHECK(model.two_lines);
+  CHECK(model.display_on);
+
+  // Text, numbers and cursor positioning
+  lcd.print(F("Hello World"));
+  lcd.cursor_set(0, 1);
+  lcd.print(-1234);
+  lcd.print(' ');
+  lcd.print_float(3.14159, 3);
+  model.poll();
+  CHECK_TEXT(model, ROW[0], "Hello World         ");
+  CHECK_TEXT(model, ROW[1], "-1234 3.142         ");
+
+  // Fill last line; cursor after the last column. Custom character
+  // write restores the address counter to the cursor position
+  lcd.cursor_set(0, 3);
+  lcd.print(F("ABCDEFGHIJKLMNOPQRST"));
+  lcd.cgram_write(1, 0, BITMAP, sizeof(BITMAP));
+  model.poll();
+  CHECK_TEXT(model, ROW[3], "ABCDEFGHIJKLMNOPQRST");
+  CHECK(memcmp(&model.cgram[8], BITMAP, sizeof(BITMAP)) == 0);
+  CHECK(!model.cgram_mode);
+  CHECK(model.ac == ROW[3] + 20);
+
+  // Line wrap on the last line; new-line clears the first line
+  lcd.print('X');
+  model.poll();
+  CHECK_TEXT(model, ROW[0], "X                   ");
+  CHECK_TEXT(model, ROW[3], "ABCDEFGHIJKLMNOPQRST");
+
+  // Clear display
+  lcd.display_clear();
+  lcd.print(F("clear"));
+  model.poll();
+  CHECK_TEXT(model, ROW[0], "clear ");
+  CHECK_TEXT(model, ROW[3], "                    ");
+
+  // Attached field; clear invalidates the rendered text so that an
+  // update with an unchanged value is written again
+  LCD::Field<6> field(14, 2);
+  lcd.attach(field);
+  lcd.update(field, 42);
+  model.poll();
+  CHECK_TEXT(model, ROW[2] + 14, "    42");
+  CHECK(lcd.update(field, 42) == 0);
+  lcd.display_clear();
+  lcd.update(field, 42);
+  model.poll();
+  CHECK_TEXT(model, ROW[2] + 14, "    42");
+  lcd.write('\f');
+  lcd.update(field, 42);
+  model.poll();
+  CHECK_TEXT(model, ROW[2] + 14, "    42");
+  lcd.detach(field);
+
+  // Erase display escape sequences; 0 to end, 1 to cursor, 2 all
+  lcd.escape_sequence_on();
+  for (uint8_t y = 0; y < 4; y++) {
+    lcd.cursor_set(0, y);
+    lcd.print(F("ABCDEFGHIJKLMNOPQRST"));
+  }
+  lcd.print(F("\033[2;5H\033[J"));
+  model.poll();
+  CHECK_TEXT(model, ROW[0], "ABCDEFGHIJKLMNOPQRST");
+  CHECK_TEXT(model, ROW[1], "ABCD                ");
+  CHECK_TEXT(model, ROW[2], "                    ");
+  CHECK_TEXT(model, ROW[3], "                    ");
+  lcd.print(F("\033[1;3H\033[1J"));
+  model.poll();
+  CHECK_TEXT(model, ROW[0], "   DEFGHIJKLMNOPQRST");
+  lcd.print(F("\033[2;2H\033[0J"));
+  lcd.print('x');
+  model.poll();
+  CHECK_TEXT(model, ROW[0], "   DEFGHIJKLMNOPQRST");
+  CHECK_TEXT(model, ROW[1], "Ax                  ");
+  lcd.print(F("\033[2J"));
+  lcd.print('y');
+  model.poll();
+  CHECK_TEXT(model, ROW[0], "                    ");
+  CHECK_TEXT(model, ROW[1], "  y                 ");
+  lcd.escape_sequence_off();
+  lcd.display_clear();
+
+  // Big number; the display cursor is restored after the update
+  LCD::BigNumber<2> big(lcd, 12, 2);
+  big.begin();
+  lcd.display_clear();
+  lcd.print(F("big"));
+  big.update(42);
+  lcd.print('!');
+  model.poll();
+  CHECK_TEXT(model, ROW[0], "big!");
+  CHECK(model.ddram[ROW[2] + 16] == 6);
+  big.digit(0, LCD::BigNumber<2>::BLANK);
+  lcd.print('?');
+  model.poll();
+  CHECK_TEXT(model, ROW[0], "big!?");
+  CHECK_TEXT(model, ROW[2] + 12, "   ");
+  lcd.display_clear();
+
+  // Marquee on 16x1 display with split line; the visible window is
+  // rewritten instead of shifting the display
+  HD44780 split(io, 16, 1, 8);
+  LCD::Marquee marquee(split, 0, 100);
+  split.begin();
+  split.print(F(">"));
+  marquee.begin("ABCDEFGHIJKLMNOPQRSTUV");
+  model.poll();
+  CHECK_TEXT(model, 0x00, "ABCDEFGH");
+  CHECK_TEXT(model, 0x40, "IJKLMNOP");
+  for (uint8_t i = 0; i < 3; i++) marquee.step();
+  split.print(F("<"));
+  model.poll();
+  CHECK(model.shift == 0);
+  CHECK_TEXT(model, 0x00, "D<FGHIJK");
+  CHECK_TEXT(model, 0x40, "LMNOPQRS");
+
+  // Compile-time geometry; line wrap, new-line and split line
+  HD44780_2004 lcd2004(io);
+  lcd2004.begin();
+  lcd2004.print(F("0123456789ABCDEFGHIJwrap"));
+  lcd2004.cursor_set(0, 3);
+  lcd2004.print(F("last\nfirst"));
+  model.poll();
+  CHECK_TEXT(model, ROW[0], "first               ");
+  CHECK_TEXT(model, ROW[1], "wrap                ");
+  CHECK_TEXT(model, ROW[3], "last                ");
+  lcd2004.cursor_set(18, 1);
+  lcd2004.write('x');
+  lcd2004.write('y');
+  lcd2004.write('z');
+  model.poll();
+  CHECK_TEXT(model, ROW[1], "wrap              xy");
+  CHECK_TEXT(model, ROW[2], "z                   ");
+  HD44780_1601 lcd1601(io);
+  lcd1601.begin();
+  lcd1601.print(F("ABCDEFGHIJKLMNOPQR"));
+  model.poll();
+  CHECK_TEXT(model, 0x00, "QR      ");
+  CHECK_TEXT(model, 0x40, "        ");
+  lcd1601.print(F("\rABCDEFGHIJ"));
+  model.poll();
+  CHECK_TEXT(model, 0x00, "ABCDEFGH");
+  CHECK_TEXT(model, 0x40, "IJ      ");
+
+  // Start without blocking; output before ready is queued
+  uint8_t queue[32];
+  model.reset();
+  lcd.queue(queue, sizeof(queue));
+  lcd.begin_async();
+  lcd.set_custom_char(2, BITMAP);
+  lcd.cursor_set(2, 1);
+  lcd.print(F("queued"));
+  while (!lcd.poll()) model.poll();
+  model.poll();
+  CHECK(memcmp(&model.cgram[16], BITMAP, sizeof(BITMAP)) == 0);
+  CHECK_TEXT(model, ROW[1], "  queued");
+  CHECK(model.display_on);
+
+  // Control settings before ready are written by the initialization,
+  // display shift is queued
+  model.reset();
+  lcd.begin_async();
+  lcd.display_off();
+  lcd.cursor_underline_on();
+  lcd.display_scroll_left();
+  while (!lcd.poll()) model.poll();
+  model.poll();
+  CHECK(!model.display_on);
+  CHECK(model.cursor_on);
+  CHECK(model.shift == -1);
+  lcd.display_on();
+  lcd.cursor_underline_off();
+  lcd.display_scroll_right();
+  model.poll();
+  CHECK(model.display_on);
+  CHECK(!model.cursor_on);
+  CHECK(model.shift == 0);
+  lcd.queue(NULL, 0);
+
+  // No instruction within the execution time and no lost edges
+  CHECK(model.violations == 0);
+  CHECK(model.overruns == 0);
+}
+
+TEST_MAIN(test)
@@ -0,0 +1,102 @@
+/**
+ * @file test/TWI_Scheduler.cpp
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#include "Test.h"
+#include "TWI.h"
+#include "Hardware/TWI.h"
+#include "LCD.h"
+#include "Driver/HD44780.h"
+#include "Adapter/MJKDZ.h"
+#include "Adapter/TWI_Scheduler.h"
+
+// Four HD44780 16x2 on MJKDZ boards (sub-address 0..3) on a shared
+// scheduled 400 kHz bus; the interleaved expander port writes are
+// decoded to display data memory per display
+
+const uint8_t LCD_MAX = 4;
+
+Hardware::TWI twi(400000UL);
+LCD::TWI_Scheduler scheduler(twi);
+LCD::TWI_Scheduler::Queue q0(scheduler);
+LCD::TWI_Scheduler::Queue q1(scheduler);
+LCD::TWI_Scheduler::Queue q2(scheduler);
+LCD::TWI_Scheduler::Queue q3(scheduler);
+LCD::Scheduled<LCD::MJKDZ> port0(q0, 0);
+LCD::Scheduled<LCD::MJKDZ> port1(q1, 1);
+LCD::Scheduled<LCD::MJKDZ> port2(q2, 2);
+LCD::Scheduled<LCD::MJKDZ> port3(q3, 3);
+HD44780 lcd0(port0);
+HD44780 lcd1(port1);
+HD44780 lcd2(port2);
+HD44780 lcd3(port3);
+HD44780* lcd[LCD_MAX] = { &lcd0, &lcd1, &lcd2, &lcd3 };
+Host::HD44780_Model model[LCD_MAX];
+
+void test()
+{
+  char line[17];
+
+  // MJKDZ: data P0..P3, EN P4, RS P6
+  for (uint8_t i = 0; i < LCD_MAX; i++) {
+    model[i].attach(Host::pcf8574[i], 0, 6, 4);
+    lcd[i]->begin();
+  }
+  scheduler.flush();
+
+  // Different text on each display; clear holds are interleaved
+  // with the transfers to the other displays
+  for (uint8_t i = 0; i < LCD_MAX; i++) {
+    lcd[i]->display_clear();
+    lcd[i]->print(F("display "));
+    lcd[i]->print(i);
+    lcd[i]->cursor_set(0, 1);
+    lcd[i]->print(F("0123456789ABCDEF"));
+  }
+  scheduler.flush();
+  for (uint8_t i = 0; i < LCD_MAX; i++) {
+    sprintf(line, "display %u       ", i);
+    CHECK_TEXT(model[i], 0x00, line);
+    CHECK_TEXT(model[i], 0x40, "0123456789ABCDEF");
+  }
+
+  // Idle bus for more than half the micros() range; the hold of the
+  // last clear must not block the queues
+  for (uint8_t i = 0; i < LCD_MAX; i++) lcd[i]->display_clear();
+  scheduler.flush();
+  Host::advance(0x80000000UL + 1000);
+  for (uint8_t i = 0; i < LCD_MAX; i++) {
+    lcd[i]->print(F("after "));
+    lcd[i]->print(LCD_MAX - i);
+  }
+  uint16_t runs = 0;
+  while (!scheduler.is_idle() && runs < 1000) {
+    scheduler.run();
+    runs += 1;
+  }
+  CHECK(scheduler.is_idle());
+  for (uint8_t i = 0; i < LCD_MAX; i++) {
+    sprintf(line, "after %u         ", LCD_MAX - i);
+    CHECK_TEXT(model[i], 0x00, line);
+  }
+
+  // No instruction within the execution time on any display
+  for (uint8_t i = 0; i < LCD_MAX; i++)
+    CHECK(model[i].violations == 0);
+}
+
+TEST_MAIN(test)
@@ -0,0 +1,93 @@
+/**
+ * @file test/Test.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include "Arduino.h"
+#include "HD44780_Model.h"
+
+/**
+ * Minimal host test support; checks are counted and failures are
+ * printed on standard error with the source line. The test program
+ * returns the number of failures (ctest passes on zero).
+ */
+namespace Test {
+extern uint16_t failures;
+
+/**
+ * Record check result; print failure with given source location and
+ * expression.
+ * @param[in] ok check result.
+ * @param[in] file source file.
+ * @param[in] line source line.
+ * @param[in] expr expression.
+ * @return check result.
+ */
+inline bool check(bool ok, const char* file, int line, const char* expr)
+{
+  if (!ok) {
+    fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+    failures += 1;
+  }
+  return (ok);
+}
+
+/**
+ * Check that the given controller model display data memory at the
+ * given address starts with the given text.
+ * @param[in] model controller model.
+ * @param[in] addr display data address.
+ * @param[in] expected text.
+ * @param[in] file source file.
+ * @param[in] line source line.
+ * @return check result.
+ */
+inline bool check_text(const Host::HD44780_Model& model, uint8_t addr,
+		       const char* expected, const char* file, int line)
+{
+  char buf[128];
+  uint8_t n = strlen(expected);
+  model.text(buf, addr, n);
+  if (strcmp(buf, expected) == 0) return (true);
+  fprintf(stderr, "%s:%d: ddram[0x%02x] \"%s\", expected \"%s\"\n",
+	  file, line, addr, buf, expected);
+  failures += 1;
+  return (false);
+}
+};
+
+/** Check given expression. */
+#define CHECK(expr) Test::check((expr), __FILE__, __LINE__, #expr)
+
+/** Check display data memory text of given model at given address. */
+#define CHECK_TEXT(model, addr, expected)				\
+  Test::check_text(model, addr, expected, __FILE__, __LINE__)
+
+/** Define test program main; runs the given test function. */
+#define TEST_MAIN(test)							\
+  uint16_t Test::failures = 0;						\
+  int main()								\
+  {									\
+    if (getenv("HOST_TRACE") != NULL) Host::trace = stderr;		\
+    test();								\
+    if (Test::failures != 0)						\
+      fprintf(stderr, "%u failure(s)\n", Test::failures);		\
+    return (Test::failures != 0);					\
+  }
+#endif
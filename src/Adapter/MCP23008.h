@@ -0,0 +1,212 @@
+/**
+ * @file LCD/Adapter/MCP23008.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef LCD_ADAPTER_MCP23008_H
+#define LCD_ADAPTER_MCP23008_H
+
+#include "LCD.h"
+#include "Driver/HD44780.h"
+#include "TWI.h"
+
+/**
+ * Adapter for HD44780 (LCD-II) Dot Matix Liquid Crystal Display
+ * Controller/Driver when using the MCP23008 I2C IO expander in 4-bit
+ * mode (e.g. Adafruit I2C/SPI LCD backpack). The expander is set to
+ * byte mode (no address increment) so that a buffer of port settings
+ * is written to the output latch register with a single transfer;
+ * one register address byte followed by four port bytes per
+ * character.
+ *
+ * @section Circuit
+ * @code
+ *                         MCP23008
+ *                       +----U----+
+ * (SCL/A5)------------1-|SCL   VCC|-18--------------(VCC)
+ * (SDA/A4)------------2-|SDA   GP7|-17-----------(LCD BT)
+ * (GND)---[ ]---------3-|A2    GP6|-16-----------(LCD D7)
+ * (GND)---[ ]---------4-|A1    GP5|-15-----------(LCD D6)
+ * (GND)---[ ]---------5-|A0    GP4|-14-----------(LCD D5)
+ * (VCC)---------------6-|/RST  GP3|-13-----------(LCD D4)
+ *                     7-|NC    GP2|-12-----------(LCD EN)
+ *                     8-|INT   GP1|-11-----------(LCD RS)
+ * (GND)---------------9-|GND   GP0|-10
+ *                       +---------+
+ * (LCD RW)---------------------------------------(GND)
+ * @endcode
+ */
+namespace LCD {
+class MCP23008 : public HD44780::Adapter, private TWI::Device {
+public:
+  /**
+   * Construct HD44780 adapter when using the MCP23008 I2C/TWI
+   * I/O expander with given sub-address (A0..A2).
+   * @param[in] twi bus manager.
+   * @param[in] subaddr sub-address (0..7, default 0).
+   */
+  MCP23008(TWI& twi, uint8_t subaddr = 0) :
+    TWI::Device(twi, 0x20 | (subaddr & 0x07)),
+    m_port()
+  {}
+
+  /**
+   * @override{HD44780::Adapter}
+   * Initiate expander; byte mode and all pins output. Returns false.
+   * @return bool.
+   */
+  virtual bool setup()
+  {
+    uint8_t buf[2];
+    buf[0] = IOCON;
+    buf[1] = SEQOP;
+    transfer(buf, sizeof(buf));
+    buf[0] = IODIR;
+    buf[1] = 0;
+    transfer(buf, sizeof(buf));
+    return (false);
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Write nibble to display using TWI interface.
+   * @param[in] data (4b) to write.
+   */
+  virtual void write4b(uint8_t data)
+  {
+    uint8_t buf[3];
+    buf[0] = OLAT;
+    m_port.data = data;
+    m_port.en = 1;
+    buf[1] = m_port;
+    m_port.en = 0;
+    buf[2] = m_port;
+    transfer(buf, sizeof(buf));
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Write byte (8bit) to display.
+   * @param[in] data (8b) to write.
+   */
+  virtual void write8b(uint8_t data)
+  {
+    write8n(&data, 1);
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Write character buffer to display. The port settings are
+   * written to the output latch register with as few transfers as
+   * possible.
+   * @param[in] buf pointer to buffer.
+   * @param[in] size number of bytes in buffer.
+   */
+  virtual void write8n(const void* buf, size_t size)
+  {
+    const uint8_t* bp = (const uint8_t*) buf;
+    while (size != 0) {
+      uint8_t tmp[33];
+      uint8_t n = (size > (sizeof(tmp) - 1) / 4 ? (sizeof(tmp) - 1) / 4 : size);
+      size -= n;
+      uint8_t m = n * 4 + 1;
+      tmp[0] = OLAT;
+      for (uint8_t i = 1; i < m;) {
+	uint8_t data = *bp++;
+	m_port.data = (data >> 4);
+	m_port.en = 1;
+	tmp[i++] = m_port;
+	m_port.en = 0;
+	tmp[i++] = m_port;
+	m_port.data = data;
+	m_port.en = 1;
+	tmp[i++] = m_port;
+	m_port.en = 0;
+	tmp[i++] = m_port;
+      }
+      transfer(tmp, m);
+    }
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Set instruction/data mode; zero for instruction,
+   * non-zero for data mode.
+   * @param[in] flag.
+   */
+  virtual void set_mode(uint8_t flag)
+  {
+    m_port.rs = flag;
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Set backlight on/off.
+   * @param[in] flag.
+   */
+  virtual void set_backlight(uint8_t flag)
+  {
+    uint8_t buf[2];
+    m_port.bt = flag;
+    buf[0] = OLAT;
+    buf[1] = m_port;
+    transfer(buf, sizeof(buf));
+  }
+
+protected:
+  /** Register addresses. */
+  enum {
+    IODIR = 0x00,		//!< I/O direction.
+    IOCON = 0x05,		//!< Configuration.
+    OLAT = 0x0a			//!< Output latch.
+  } __attribute__((packed));
+
+  /** Configuration register bits. */
+  enum {
+    SEQOP = 0x20		//!< Sequential operation disabled.
+  } __attribute__((packed));
+
+  /** Expander port bit fields; little endian. */
+  union port_t {
+    uint8_t as_uint8;		//!< Unsigned byte access.
+    struct {
+      uint8_t app:1;		//!< Application bit (GP0).
+      uint8_t rs:1;		//!< Command/Data select (GP1).
+      uint8_t en:1;		//!< Enable pulse (GP2).
+      uint8_t data:4;		//!< Data port (GP3..GP6).
+      uint8_t bt:1;		//!< Back-light (GP7).
+    };
+    operator uint8_t() { return (as_uint8); }
+    port_t() { as_uint8 = 0; }
+  };
+
+  /**
+   * Write given buffer, register address and data, in a single
+   * transfer.
+   * @param[in] buf pointer to buffer.
+   * @param[in] size number of bytes.
+   */
+  void transfer(const uint8_t* buf, uint8_t size)
+  {
+    acquire();
+    write(buf, size);
+    release();
+  }
+
+  port_t m_port;		//!< Port setting.
+};
+};
+#endif
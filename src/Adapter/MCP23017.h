@@ -0,0 +1,210 @@
+/**
+ * @file LCD/Adapter/MCP23017.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef LCD_ADAPTER_MCP23017_H
+#define LCD_ADAPTER_MCP23017_H
+
+#include "LCD.h"
+#include "Driver/HD44780.h"
+#include "TWI.h"
+
+/**
+ * Adapter for HD44780 (LCD-II) Dot Matix Liquid Crystal Display
+ * Controller/Driver when using the MCP23017 I2C IO expander in 8-bit
+ * mode. The data port is connected to GPB and the control signals
+ * to GPA. The expander is set to byte mode where the register
+ * address toggles between the output latch registers of port A and
+ * B. A buffer of characters is written with a single transfer; one
+ * register address byte followed by four port bytes per character
+ * (data, enable high, data, enable low).
+ *
+ * @section Circuit
+ * @code
+ *                         MCP23017
+ *                       +----U----+
+ * (LCD D0)------------1-|GPB0 GPA7|-28
+ * (LCD D1)------------2-|GPB1 GPA6|-27
+ * (LCD D2)------------3-|GPB2 GPA5|-26
+ * (LCD D3)------------4-|GPB3 GPA4|-25
+ * (LCD D4)------------5-|GPB4 GPA3|-24-----------(LCD BT)
+ * (LCD D5)------------6-|GPB5 GPA2|-23-----------(LCD EN)
+ * (LCD D6)------------7-|GPB6 GPA1|-22-----------(LCD RW)
+ * (LCD D7)------------8-|GPB7 GPA0|-21-----------(LCD RS)
+ * (VCC)---------------9-|VDD  INTA|-20
+ * (GND)--------------10-|VSS  INTB|-19
+ *                    11-|NC   /RST|-18--------------(VCC)
+ * (SCL/A5)-----------12-|SCL    A2|-17---[ ]--------(GND)
+ * (SDA/A4)-----------13-|SDA    A1|-16---[ ]--------(GND)
+ *                    14-|NC     A0|-15---[ ]--------(GND)
+ *                       +---------+
+ * @endcode
+ */
+namespace LCD {
+class MCP23017 : public HD44780::Adapter, private TWI::Device {
+public:
+  /**
+   * Construct HD44780 adapter when using the MCP23017 I2C/TWI
+   * I/O expander with given sub-address (A0..A2).
+   * @param[in] twi bus manager.
+   * @param[in] subaddr sub-address (0..7, default 0).
+   */
+  MCP23017(TWI& twi, uint8_t subaddr = 0) :
+    TWI::Device(twi, 0x20 | (subaddr & 0x07)),
+    m_port()
+  {}
+
+  /**
+   * @override{HD44780::Adapter}
+   * Initiate expander; byte mode and all pins output. Returns true
+   * for 8-bit mode.
+   * @return true(1).
+   */
+  virtual bool setup()
+  {
+    uint8_t buf[3];
+    buf[0] = IOCON;
+    buf[1] = SEQOP;
+    transfer(buf, 2);
+    buf[0] = IODIRA;
+    buf[1] = 0;
+    buf[2] = 0;
+    transfer(buf, 3);
+    return (true);
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Write LSB nibble to display.
+   * @param[in] data (4b) to write.
+   */
+  virtual void write4b(uint8_t data)
+  {
+    write8b(data);
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Write byte (8bit) to display.
+   * @param[in] data (8b) to write.
+   */
+  virtual void write8b(uint8_t data)
+  {
+    write8n(&data, 1);
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Write character buffer to display. The data and control port
+   * settings are written alternately with as few transfers as
+   * possible.
+   * @param[in] buf pointer to buffer.
+   * @param[in] size number of bytes in buffer.
+   */
+  virtual void write8n(const void* buf, size_t size)
+  {
+    const uint8_t* bp = (const uint8_t*) buf;
+    while (size != 0) {
+      uint8_t tmp[33];
+      uint8_t n = (size > (sizeof(tmp) - 1) / 4 ? (sizeof(tmp) - 1) / 4 : size);
+      size -= n;
+      uint8_t m = n * 4 + 1;
+      tmp[0] = OLATB;
+      for (uint8_t i = 1; i < m;) {
+	uint8_t data = *bp++;
+	tmp[i++] = data;
+	m_port.en = 1;
+	tmp[i++] = m_port;
+	tmp[i++] = data;
+	m_port.en = 0;
+	tmp[i++] = m_port;
+      }
+      transfer(tmp, m);
+    }
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Set instruction/data mode; zero for instruction,
+   * non-zero for data mode.
+   * @param[in] flag.
+   */
+  virtual void set_mode(uint8_t flag)
+  {
+    m_port.rs = flag;
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Set backlight on/off.
+   * @param[in] flag.
+   */
+  virtual void set_backlight(uint8_t flag)
+  {
+    uint8_t buf[2];
+    m_port.bt = flag;
+    buf[0] = OLATA;
+    buf[1] = m_port;
+    transfer(buf, sizeof(buf));
+  }
+
+protected:
+  /** Register addresses (IOCON.BANK = 0). */
+  enum {
+    IODIRA = 0x00,		//!< I/O direction, port A.
+    IODIRB = 0x01,		//!< I/O direction, port B.
+    IOCON = 0x0a,		//!< Configuration.
+    OLATA = 0x14,		//!< Output latch, port A.
+    OLATB = 0x15		//!< Output latch, port B.
+  } __attribute__((packed));
+
+  /** Configuration register bits. */
+  enum {
+    SEQOP = 0x20		//!< Sequential operation disabled.
+  } __attribute__((packed));
+
+  /** Control port bit fields; little endian. */
+  union port_t {
+    uint8_t as_uint8;		//!< Unsigned byte access.
+    struct {
+      uint8_t rs:1;		//!< Command/Data select (GPA0).
+      uint8_t rw:1;		//!< Read/Write (GPA1).
+      uint8_t en:1;		//!< Enable pulse (GPA2).
+      uint8_t bt:1;		//!< Back-light (GPA3).
+      uint8_t app:4;		//!< Application bits (GPA4..GPA7).
+    };
+    operator uint8_t() { return (as_uint8); }
+    port_t() { as_uint8 = 0; }
+  };
+
+  /**
+   * Write given buffer, register address and data, in a single
+   * transfer.
+   * @param[in] buf pointer to buffer.
+   * @param[in] size number of bytes.
+   */
+  void transfer(const uint8_t* buf, uint8_t size)
+  {
+    acquire();
+    write(buf, size);
+    release();
+  }
+
+  port_t m_port;		//!< Control port setting.
+};
+};
+#endif
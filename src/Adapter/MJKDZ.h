@@ -22,7 +22,7 @@
 #include "LCD.h"
 #include "Driver/HD44780.h"
 #include "TWI.h"
-#include "Driver/PCF8574.h"
+#include "PCF8574_Adapter.h"
 
 /**
  * Adapter for HD44780 (LCD-II) Dot Matix Liquid Crystal Display
@@ -45,7 +45,7 @@
  * @endcode
  */
 namespace LCD {
-class MJKDZ : public HD44780::Adapter, private PCF8574 {
+class MJKDZ : public PCF8574_Adapter {
 public:
   /**
    * Construct HD44780 adapter when using the MJKDZ I2C/TWI
@@ -53,21 +53,10 @@ public:
    * @param[in] subaddr sub-address (0..7, default 7).
    */
   MJKDZ(TWI& twi, uint8_t subaddr = 7) :
-    PCF8574(twi, subaddr),
+    PCF8574_Adapter(twi, subaddr),
     m_port()
   {}
 
-  /**
-   * @override{HD44780::Adapter}
-   * Initiate TWI interface. Returns false.
-   * @return bool.
-   */
-  virtual bool setup()
-  {
-    ddr(0);
-    return (false);
-  }
-
   /**
    * @override{HD44780::Adapter}
    * Write nibble to display using TWI interface.
@@ -81,7 +70,7 @@ public:
     buf[0] = m_port;
     m_port.en = 0;
     buf[1] = m_port;
-    write(buf, sizeof(buf));
+    transfer(buf, sizeof(buf));
   }
 
   /**
@@ -102,7 +91,7 @@ public:
     buf[2] = m_port;
     m_port.en = 0;
     buf[3] = m_port;
-    write(buf, sizeof(buf));
+    transfer(buf, sizeof(buf));
   }
 
   /**
@@ -132,7 +121,7 @@ public:
 	m_port.en = 0;
 	tmp[i++] = m_port;
       }
-      write(tmp, m);
+      transfer(tmp, m);
     }
   }
 
@@ -155,7 +144,7 @@ public:
   virtual void set_backlight(uint8_t flag)
   {
     m_port.bt = !flag;
-    write(m_port.as_uint8);
+    transfer(&m_port.as_uint8, 1);
   }
 
 protected:
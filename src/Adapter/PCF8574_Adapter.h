@@ -0,0 +1,116 @@
+/**
+ * @file LCD/Adapter/PCF8574_Adapter.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef LCD_ADAPTER_PCF8574_ADAPTER_H
+#define LCD_ADAPTER_PCF8574_ADAPTER_H
+
+#include "LCD.h"
+#include "Driver/HD44780.h"
+#include "TWI.h"
+#include "Driver/PCF8574.h"
+
+/**
+ * Common base for HD44780 adapters on PCF8574 I2C IO expander
+ * boards (MJKDZ, GY-IICLCD and DFRobot). Handles port setup and
+ * output batches; port data written within a batch is collected and
+ * written with as few TWI transfers as possible. The board adapter
+ * defines the port bit layout and writes port data with transfer().
+ */
+namespace LCD {
+class PCF8574_Adapter : public HD44780::Adapter, protected PCF8574 {
+public:
+  /**
+   * Construct HD44780 adapter on PCF8574 I/O expander with given
+   * sub-address (A0..A2).
+   * @param[in] twi bus manager.
+   * @param[in] subaddr sub-address (0..7).
+   */
+  PCF8574_Adapter(TWI& twi, uint8_t subaddr) :
+    PCF8574(twi, subaddr),
+    m_batch(false),
+    m_len(0)
+  {}
+
+  /**
+   * @override{HD44780::Adapter}
+   * Initiate TWI interface. Returns false.
+   * @return bool.
+   */
+  virtual bool setup()
+  {
+    ddr(0);
+    return (false);
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Start batch; port data is collected and written with as few
+   * TWI transfers as possible.
+   */
+  virtual void begin_batch()
+  {
+    m_batch = true;
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * End batch; write collected port data.
+   */
+  virtual void end_batch()
+  {
+    if (m_len != 0) write(m_buf, m_len);
+    m_batch = false;
+    m_len = 0;
+  }
+
+protected:
+  /** Max number of port data bytes per batch transfer. */
+  static const uint8_t BATCH_MAX = 32;
+
+  /**
+   * Write given port data; collect if in batch. The collected data
+   * is written when the batch buffer is full.
+   * @param[in] buf pointer to port data.
+   * @param[in] size number of bytes.
+   */
+  void transfer(const uint8_t* buf, uint8_t size)
+  {
+    if (!m_batch) {
+      write(buf, size);
+      return;
+    }
+    while (size != 0) {
+      if (m_len == BATCH_MAX) {
+	write(m_buf, m_len);
+	m_len = 0;
+      }
+      uint8_t n = BATCH_MAX - m_len;
+      if (n > size) n = size;
+      memcpy(&m_buf[m_len], buf, n);
+      m_len += n;
+      buf += n;
+      size -= n;
+    }
+  }
+
+  bool m_batch;			//!< Batch in progress.
+  uint8_t m_len;		//!< Number of bytes in batch buffer.
+  uint8_t m_buf[BATCH_MAX];	//!< Batch buffer.
+};
+};
+#endif
@@ -24,7 +24,10 @@
 
 /**
  * Adapter for HD44780 (LCD-II) Dot Matix Liquid Crystal Display
- * Controller/Driver when using GPIO pins.
+ * Controller/Driver when using GPIO pins. When the data pins are
+ * contiguous bits of the same port, in order D0..D3 (e.g. LCD Keypad
+ * shield), a nibble is written with a single port update on AVR and
+ * SAM, otherwise one pin at a time.
  * @param[in] D0_PIN data pin.
  * @param[in] D1_PIN data pin.
  * @param[in] D2_PIN data pin.
@@ -69,14 +72,15 @@ template<BOARD::pin_t D0_PIN,
 	 BOARD::pin_t RS_PIN,
 	 BOARD::pin_t EN_PIN,
 	 BOARD::pin_t BT_PIN>
-class PP7W : public HD44780::Adapter {
+class PP7W : public HD44780::Adapter, protected HD44780::Exec_Timer {
 public:
   /**
    * Construct HD44780 7-wire parallel port connected to given command,
    * enable and backlight pin.
    */
   PP7W() :
-    HD44780::Adapter()
+    HD44780::Adapter(),
+    HD44780::Exec_Timer()
   {
     m_d0.output();
     m_d1.output();
@@ -95,34 +99,27 @@ public:
    */
   virtual void write4b(uint8_t data)
   {
-    m_d0.write(data & 0x01);
-    m_d1.write(data & 0x02);
-    m_d2.write(data & 0x04);
-    m_d3.write(data & 0x08);
+    write_data(data);
     m_en.toggle();
     m_en.toggle();
   }
 
   /**
    * @override{HD44780::Adapter}
-   * Write byte (8bit) to display.
+   * Write byte (8bit) to display. Waits only for the remaining
+   * execution time of the previous byte before the enable pulse.
    * @param[in] data (8b) to write.
    */
   virtual void write8b(uint8_t data)
   {
-    m_d0.write(data & 0x10);
-    m_d1.write(data & 0x20);
-    m_d2.write(data & 0x40);
-    m_d3.write(data & 0x80);
+    write_data(data >> 4);
+    exec_wait(SHORT_EXEC_TIME);
     m_en.toggle();
     m_en.toggle();
-    m_d0.write(data & 0x01);
-    m_d1.write(data & 0x02);
-    m_d2.write(data & 0x04);
-    m_d3.write(data & 0x08);
+    write_data(data);
     m_en.toggle();
     m_en.toggle();
-    delayMicroseconds(SHORT_EXEC_TIME);
+    exec_start();
   }
 
   /**
@@ -150,6 +147,47 @@ protected:
   /** Execution time delay (us). */
   static const uint16_t SHORT_EXEC_TIME = 32;
 
+  /** Data pins are contiguous bits of the same port, D0 lowest. */
+  static const bool PORT_ALIGNED =
+    (D1_PIN == D0_PIN + 1)
+    && (D2_PIN == D0_PIN + 2)
+    && (D3_PIN == D0_PIN + 3)
+    && (GPIO_MASK(D3_PIN) == (GPIO_MASK(D0_PIN) << 3));
+
+  /**
+   * Write LSB nibble to data pins; single port update when the
+   * pins are port aligned.
+   * @param[in] data (4b) to write.
+   */
+  void write_data(uint8_t data)
+  {
+#if defined(ARDUINO_ARCH_AVR)
+    if (PORT_ALIGNED) {
+      volatile uint8_t* port = ((volatile uint8_t*) GPIO_REG(D0_PIN)) + 2;
+      const uint8_t mask = GPIO_MASK(D0_PIN) * 0x0f;
+      uint8_t bits = (data & 0x0f) * GPIO_MASK(D0_PIN);
+      uint8_t sreg = SREG;
+      cli();
+      *port = (*port & ~mask) | bits;
+      SREG = sreg;
+      return;
+    }
+#elif defined(ARDUINO_ARCH_SAM)
+    if (PORT_ALIGNED) {
+      Pio* pio = GPIO_REG(D0_PIN);
+      const uint32_t mask = GPIO_MASK(D0_PIN) * 0x0f;
+      uint32_t bits = (data & 0x0f) * GPIO_MASK(D0_PIN);
+      pio->PIO_SODR = bits;
+      pio->PIO_CODR = bits ^ mask;
+      return;
+    }
+#endif
+    m_d0.write(data & 0x01);
+    m_d1.write(data & 0x02);
+    m_d2.write(data & 0x04);
+    m_d3.write(data & 0x08);
+  }
+
   GPIO<D0_PIN> m_d0;		//!< Data pin; d0.
   GPIO<D1_PIN> m_d1;		//!< Data pin; d1.
   GPIO<D2_PIN> m_d2;		//!< Data pin; d2.
@@ -74,13 +74,14 @@
  */
 namespace LCD {
 template<BOARD::pin_t SDA_PIN, BOARD::pin_t SCL_PIN, BOARD::pin_t EN_PIN>
-class SR3W : public HD44780::Adapter {
+class SR3W : public HD44780::Adapter, protected HD44780::Exec_Timer {
 public:
   /**
    * Construct HD44780 3-wire serial adapter and initiate pins.
    */
   SR3W() :
     HD44780::Adapter(),
+    HD44780::Exec_Timer(),
     m_port()
   {
     m_sda.output();
@@ -105,29 +106,26 @@ public:
    */
   virtual void write4b(uint8_t data)
   {
-    m_port.data = data;
-    data = m_port;
-    uint8_t mask = 0x20;
-    do {
-      m_sda = data & mask;
-      m_scl.toggle();
-      mask >>= 1;
-      m_scl.toggle();
-    } while (mask);
+    shift(data);
     m_en.toggle();
     m_en.toggle();
   }
 
   /**
    * @override{HD44780::Adapter}
-   * Write byte (8bit) to display.
+   * Write byte (8bit) to display. The first nibble is shifted
+   * while the previous byte is executed; waits only for the
+   * remaining execution time before the enable pulse.
    * @param[in] data (8b) to write.
    */
   virtual void write8b(uint8_t data)
   {
-    write4b(data >> 4);
+    shift(data >> 4);
+    exec_wait(SHORT_EXEC_TIME);
+    m_en.toggle();
+    m_en.toggle();
     write4b(data);
-    delayMicroseconds(SHORT_EXEC_TIME);
+    exec_start();
   }
 
   /**
@@ -169,6 +167,23 @@ protected:
     port_t() { as_uint8 = 0; }
   };
 
+  /**
+   * Shift given 4-bit data with port setting to the shift register.
+   * @param[in] data (4b) to write.
+   */
+  void shift(uint8_t data)
+  {
+    m_port.data = data;
+    data = m_port;
+    uint8_t mask = 0x20;
+    do {
+      m_sda = data & mask;
+      m_scl.toggle();
+      mask >>= 1;
+      m_scl.toggle();
+    } while (mask);
+  }
+
   port_t m_port;		//!< Port setting.
   GPIO<SDA_PIN> m_sda;		//!< Serial data output.
   GPIO<SCL_PIN> m_scl;		//!< Serial clock.
@@ -0,0 +1,208 @@
+/**
+ * @file LCD/Adapter/SR3W_SPI.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef LCD_ADAPTER_SR3W_SPI_H
+#define LCD_ADAPTER_SR3W_SPI_H
+
+#include "LCD.h"
+#include "Driver/HD44780.h"
+#include "GPIO.h"
+#include <SPI.h>
+
+/**
+ * HD44780 (LCD-II) Dot Matix Liquid Crystal Display Controller/Driver
+ * Shift Register 3-Wire Port (SR3W), 74HC595 (SR[pin]), with
+ * hardware SPI. Same shift register port layout as SR3W; the serial
+ * data and clock are the SPI MOSI and SCK pins. A port byte is
+ * shifted in one SPI transfer (1 us at 8 MHz) instead of bit-banging.
+ *
+ * @param[in] EN_PIN enable pulse.
+ *
+ * @section Circuit
+ * @code
+ *                         74HC595    (VCC)
+ *                       +----U----+    |
+ * (LCD D5)------------1-|Q1    VCC|-16-+
+ * (LCD D6)------------2-|Q2     Q0|-15--------(LCD D4)
+ * (LCD D7)------------3-|Q3    SER|-14-----------(MOSI)
+ * (LCD RS)------------4-|Q4    /OE|-13-----------(GND)
+ * (LCD BT)------------5-|Q5   RCLK|-12--------(EN_PIN)
+ *                     6-|Q6   SCLK|-11------------(SCK)
+ *                     7-|Q7    /MR|-10-----------(VCC)
+ *                   +-8-|GND   Q6'|--9
+ *                   |   +---------+
+ *                   |      0.1uF
+ *                 (GND)-----||----(VCC)
+ * (LCD EN)------------------------------------(EN_PIN)
+ * (LCD RW)---------------------------------------(GND)
+ * (LCD K)----------------------------------------(GND)
+ * (LCD A)-----------------[330]------------------(VCC)
+ * @endcode
+ */
+namespace LCD {
+template<BOARD::pin_t EN_PIN>
+class SR3W_SPI : public HD44780::Adapter, protected HD44780::Exec_Timer {
+public:
+  /**
+   * Construct HD44780 3-wire serial adapter with hardware SPI and
+   * initiate enable pin.
+   */
+  SR3W_SPI() :
+    HD44780::Adapter(),
+    HD44780::Exec_Timer(),
+    m_port()
+  {
+    m_en.output();
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Initiate SPI bus. Use 4-bit mode. Returns false.
+   * @return bool.
+   */
+  virtual bool setup()
+  {
+    SPI.begin();
+    return (false);
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Write 4-bit data to display using shift register.
+   * @param[in] data (4b) to write.
+   */
+  virtual void write4b(uint8_t data)
+  {
+    SPI.beginTransaction(SPISettings(FREQ, MSBFIRST, SPI_MODE0));
+    shift(data);
+    strobe();
+    SPI.endTransaction();
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Write byte (8bit) to display. The first nibble is shifted
+   * while the previous byte is executed.
+   * @param[in] data (8b) to write.
+   */
+  virtual void write8b(uint8_t data)
+  {
+    SPI.beginTransaction(SPISettings(FREQ, MSBFIRST, SPI_MODE0));
+    transfer(data);
+    SPI.endTransaction();
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Write character buffer to display. The bus is held for the
+   * whole buffer.
+   * @param[in] buf pointer to buffer.
+   * @param[in] size number of bytes in buffer.
+   */
+  virtual void write8n(const void* buf, size_t size)
+  {
+    const uint8_t* bp = (const uint8_t*) buf;
+    SPI.beginTransaction(SPISettings(FREQ, MSBFIRST, SPI_MODE0));
+    while (size--) transfer(*bp++);
+    SPI.endTransaction();
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Set instruction/data mode using given rs pin; zero for
+   * instruction, non-zero for data mode.
+   * @param[in] flag.
+   */
+  virtual void set_mode(uint8_t flag)
+  {
+    m_port.rs = flag;
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Set backlight on/off using bt pin.
+   * @param[in] flag.
+   */
+  virtual void set_backlight(uint8_t flag)
+  {
+    m_port.bt = flag;
+  }
+
+protected:
+  /** Execution time delay (us). */
+  static const uint16_t SHORT_EXEC_TIME = 32;
+
+  /** SPI clock frequency (Hz). */
+  static const uint32_t FREQ = 8000000UL;
+
+  /** Shift register port bit fields; little endian. */
+  union port_t {
+    uint8_t as_uint8;		//!< Unsigned byte access.
+    struct {
+      uint8_t data:4;		//!< Data port (Q0..Q3).
+      uint8_t rs:1;		//!< Command/Data select (Q4).
+      uint8_t bt:1;		//!< Back-light control (Q5).
+      uint8_t app2:1;		//!< Application bit#2 (Q6).
+      uint8_t app1:1;		//!< Application bit#1 (Q7).
+    };
+    operator uint8_t() { return (as_uint8); }
+    port_t() { as_uint8 = 0; }
+  };
+
+  /**
+   * Shift given 4-bit data with port setting. Should be called
+   * within an SPI transaction.
+   * @param[in] data (4b) to write.
+   */
+  void shift(uint8_t data)
+  {
+    m_port.data = data;
+    SPI.transfer(m_port);
+  }
+
+  /**
+   * Strobe enable pulse; latch shift register and start display
+   * read.
+   */
+  void strobe()
+  {
+    m_en.toggle();
+    m_en.toggle();
+  }
+
+  /**
+   * Write byte (8bit) as two nibbles. Waits only for the remaining
+   * execution time of the previous byte before the first enable
+   * pulse. Should be called within an SPI transaction.
+   * @param[in] data (8b) to write.
+   */
+  void transfer(uint8_t data)
+  {
+    shift(data >> 4);
+    exec_wait(SHORT_EXEC_TIME);
+    strobe();
+    shift(data);
+    strobe();
+    exec_start();
+  }
+
+  port_t m_port;		//!< Port setting.
+  GPIO<EN_PIN> m_en;		//!< Starts data read/write.
+};
+};
+#endif
@@ -90,7 +90,7 @@ template<BOARD::pin_t SDA_PIN,
 	 BOARD::pin_t SCL_PIN,
 	 BOARD::pin_t EN_PIN,
 	 BOARD::pin_t BT_PIN>
-class SR4W : public HD44780::Adapter {
+class SR4W : public HD44780::Adapter, protected HD44780::Exec_Timer {
 public:
   /**
    * Construct HD44780 4-wire/8-bit serial port connected to given
@@ -98,6 +98,7 @@ public:
    */
   SR4W() :
     HD44780::Adapter(),
+    HD44780::Exec_Timer(),
     m_rs(0)
   {
     m_sda.output();
@@ -128,7 +129,9 @@ public:
 
   /**
    * @override{HD44780::Adapter}
-   * Write byte (8bit) to display.
+   * Write byte (8bit) to display. The byte is shifted while the
+   * previous byte is executed; waits only for the remaining
+   * execution time before the enable pulse.
    * @param[in] data (8b) to write.
    */
   virtual void write8b(uint8_t data)
@@ -141,9 +144,10 @@ public:
       m_scl.toggle();
     } while (mask);
     m_sda = m_rs;
+    exec_wait(SHORT_EXEC_TIME);
     m_en.toggle();
     m_en.toggle();
-    delayMicroseconds(SHORT_EXEC_TIME);
+    exec_start();
   }
 
   /**
@@ -0,0 +1,178 @@
+/**
+ * @file LCD/Adapter/SR4W_SPI.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef LCD_ADAPTER_SR4W_SPI_H
+#define LCD_ADAPTER_SR4W_SPI_H
+
+#include "LCD.h"
+#include "Driver/HD44780.h"
+#include "GPIO.h"
+#include <SPI.h>
+
+/**
+ * HD44780 (LCD-II) Dot Matix Liquid Crystal Display Controller/Driver
+ * Shift Register 4-Wire/8-bit Port, 74HC595 (SR[pin]), with hardware
+ * SPI. Same shift register layout as SR4W; the serial data and clock
+ * are the SPI MOSI and SCK pins. The MOSI pin is driven by the SPI
+ * hardware and cannot double as command/data select (as in SR4W), a
+ * separate rs pin is used.
+ *
+ * @param[in] EN_PIN enable pulse.
+ * @param[in] RS_PIN command/data select.
+ * @param[in] BT_PIN backlight control.
+ *
+ * @section Circuit
+ * @code
+ *                         74HC595    (VCC)
+ *                       +----U----+    |
+ * (LCD D1)------------1-|Q1    VCC|-16-+
+ * (LCD D2)------------2-|Q2     Q0|-15--------(LCD D0)
+ * (LCD D3)------------3-|Q3    /OE|-13-----------(GND)
+ * (LCD D4)------------4-|Q4    SER|-14-----------(MOSI)
+ * (LCD D5)------------5-|Q5   RCLK|-12--------(EN_PIN)
+ * (LCD D6)------------6-|Q6   SCLK|-11------------(SCK)
+ * (LCD D7)------------7-|Q7    /MR|-10-----------(VCC)
+ *                   +-8-|GND   Q6'|-9
+ *                   |   +---------+
+ *                   |      0.1uF
+ *                 (GND)-----||----(VCC)
+ *
+ * (LCD RS)------------------------------------(RS_PIN)
+ * (LCD EN)------------------------------------(EN_PIN)
+ * (LCD BT)------------------------------------(BT_PIN)
+ * (LCD RW)---------------------------------------(GND)
+ * (LCD K)----------------------------------------(GND)
+ * (LCD A)-----------------[330]------------------(VCC)
+ * @endcode
+ */
+namespace LCD {
+template<BOARD::pin_t EN_PIN, BOARD::pin_t RS_PIN, BOARD::pin_t BT_PIN>
+class SR4W_SPI : public HD44780::Adapter, protected HD44780::Exec_Timer {
+public:
+  /**
+   * Construct HD44780 4-wire/8-bit serial port with hardware SPI
+   * and given enable, command/data select and backlight control
+   * pins.
+   */
+  SR4W_SPI() :
+    HD44780::Adapter(),
+    HD44780::Exec_Timer()
+  {
+    m_en.output();
+    m_rs.output();
+    m_bt.output();
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Initiate SPI bus. Use 8-bit mode.
+   * @return true(1).
+   */
+  virtual bool setup()
+  {
+    SPI.begin();
+    return (true);
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Write LSB nibble to display using serial port.
+   * @param[in] data (4b) to write.
+   */
+  virtual void write4b(uint8_t data)
+  {
+    write8b(data);
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Write byte (8bit) to display.
+   * @param[in] data (8b) to write.
+   */
+  virtual void write8b(uint8_t data)
+  {
+    SPI.beginTransaction(SPISettings(FREQ, MSBFIRST, SPI_MODE0));
+    shift(data);
+    SPI.endTransaction();
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Write character buffer to display. The bus is held for the
+   * whole buffer.
+   * @param[in] buf pointer to buffer.
+   * @param[in] size number of bytes in buffer.
+   */
+  virtual void write8n(const void* buf, size_t size)
+  {
+    const uint8_t* bp = (const uint8_t*) buf;
+    SPI.beginTransaction(SPISettings(FREQ, MSBFIRST, SPI_MODE0));
+    while (size--) shift(*bp++);
+    SPI.endTransaction();
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Set instruction/data mode using given rs pin; zero for
+   * instruction, non-zero for data mode.
+   * @param[in] flag.
+   */
+  virtual void set_mode(uint8_t flag)
+  {
+    m_rs.write(flag);
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Set backlight on/off using bt pin.
+   * @param[in] flag.
+   */
+  virtual void set_backlight(uint8_t flag)
+  {
+    m_bt.write(flag);
+  }
+
+protected:
+  /** Execution time delay (us). */
+  static const uint16_t SHORT_EXEC_TIME = 30;
+
+  /** SPI clock frequency (Hz). */
+  static const uint32_t FREQ = 8000000UL;
+
+  /**
+   * Shift given data and strobe enable pulse. The data is shifted
+   * while the previous byte is executed; waits only for the
+   * remaining execution time before the enable pulse. Should be
+   * called within an SPI transaction.
+   * @param[in] data (8b) to write.
+   */
+  void shift(uint8_t data)
+  {
+    SPI.transfer(data);
+    exec_wait(SHORT_EXEC_TIME);
+    m_en.toggle();
+    m_en.toggle();
+    exec_start();
+  }
+
+  GPIO<EN_PIN> m_en;		//!< Starts data read/write.
+  GPIO<RS_PIN> m_rs;		//!< Command/Data select.
+  GPIO<BT_PIN> m_bt;		//!< Backlight control.
+};
+};
+#endif
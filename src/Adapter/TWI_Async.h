@@ -0,0 +1,327 @@
+/**
+ * @file LCD/Adapter/TWI_Async.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef LCD_ADAPTER_TWI_ASYNC_H
+#define LCD_ADAPTER_TWI_ASYNC_H
+
+#include "LCD.h"
+#include "Driver/HD44780.h"
+#include "TWI.h"
+
+#if defined(ARDUINO_ARCH_AVR)
+#include <avr/interrupt.h>
+#include <util/twi.h>
+
+/**
+ * Interrupt-driven AVR hardware TWI bus with background write. Write
+ * transactions are copied to a ring buffer and transferred by the
+ * TWI interrupt handler. The caller only blocks when the ring buffer
+ * is full. Read waits for pending writes and is performed
+ * synchronously. Used with the PCF8574 based HD44780 adapters, see
+ * Async, so that display output over TWI overlaps with the
+ * application.
+ *
+ * The TWI interrupt handler and the bus instance pointer are defined
+ * in the translation unit that defines LCD_TWI_ASYNC_IMPL before the
+ * include, normally the sketch; exactly one translation unit should
+ * define it. May not be used together with the Wire library.
+ *
+ * @section Example
+ * @code
+ * #define LCD_TWI_ASYNC_IMPL
+ * #include "Adapter/TWI_Async.h"
+ * ...
+ * LCD::TWI_Async twi(400000UL);
+ * LCD::Async<LCD::MJKDZ> port(twi);
+ * HD44780 lcd(port);
+ * ...
+ * lcd.print(value);
+ * while (!lcd.idle()) work();
+ * @endcode
+ */
+namespace LCD {
+class TWI_Async : public ::TWI {
+public:
+  /** Size of ring buffer; power of two. */
+  static const uint8_t BUFFER_MAX = 128;
+
+  /** Max number of data bytes per transaction. */
+  static const uint8_t DATA_MAX = BUFFER_MAX - 3;
+
+  /**
+   * Construct interrupt-driven TWI bus with given bus frequency.
+   * @param[in] freq bus frequency in Hz (Default 100 kHz).
+   */
+  TWI_Async(uint32_t freq = 100000UL) :
+    ::TWI(),
+    m_put(0),
+    m_get(0),
+    m_addr(0),
+    m_len(0),
+    m_busy(false)
+  {
+    s_twi = this;
+    digitalWrite(SDA, HIGH);
+    digitalWrite(SCL, HIGH);
+    TWSR = 0;
+    TWBR = ((F_CPU / freq) - 16) / 2;
+    TWCR = _BV(TWEN);
+  }
+
+  /**
+   * Returns true(1) if all write transactions have been transferred
+   * otherwise false(0).
+   * @return bool.
+   */
+  bool is_idle() const
+  {
+    return (!m_busy);
+  }
+
+  /**
+   * Wait for all write transactions to be transferred.
+   */
+  void flush()
+  {
+    while (m_busy);
+  }
+
+  /**
+   * @override{TWI}
+   * Read given number of bytes from device with given address into
+   * given buffer. Waits for pending write transactions. Returns
+   * number of bytes read or negative error code.
+   * @param[in] addr device address.
+   * @param[in] buf pointer to buffer.
+   * @param[in] count number of bytes to read.
+   * @return number of bytes or negative error code.
+   */
+  virtual int read(uint8_t addr, void* buf, size_t count)
+  {
+    uint8_t* bp = (uint8_t*) buf;
+    int res = -1;
+    flush();
+    while (TWCR & _BV(TWSTO));
+    if (command(_BV(TWSTA), TW_START)) {
+      TWDR = (addr << 1) | TW_READ;
+      if (command(0, TW_MR_SLA_ACK)) {
+	res = 0;
+	while ((size_t) res < count) {
+	  bool last = ((size_t) res + 1 == count);
+	  if (!command(last ? 0 : _BV(TWEA),
+		       last ? TW_MR_DATA_NACK : TW_MR_DATA_ACK)) {
+	    res = -1;
+	    break;
+	  }
+	  bp[res++] = TWDR;
+	}
+      }
+    }
+    TWCR = _BV(TWINT) | _BV(TWEN) | _BV(TWSTO);
+    return (res);
+  }
+
+  /**
+   * @override{TWI}
+   * Write given buffer to device with given address. The buffer is
+   * copied to the ring buffer and transferred in the background.
+   * Buffers larger than DATA_MAX are transferred as several
+   * transactions. Blocks while the ring buffer is full. Returns
+   * number of bytes.
+   * @param[in] addr device address.
+   * @param[in] buf pointer to buffer.
+   * @param[in] count number of bytes to write.
+   * @return number of bytes.
+   */
+  virtual int write(uint8_t addr, const void* buf, size_t count)
+  {
+    const uint8_t* bp = (const uint8_t*) buf;
+    size_t res = count;
+    do {
+      uint8_t n = (count > DATA_MAX ? DATA_MAX : count);
+      while (available() < n + 2);
+      uint8_t put = m_put;
+      m_buf[put] = addr;
+      put = (put + 1) & MASK;
+      m_buf[put] = n;
+      put = (put + 1) & MASK;
+      for (uint8_t i = 0; i < n; i++) {
+	m_buf[put] = *bp++;
+	put = (put + 1) & MASK;
+      }
+      m_put = put;
+      start();
+      count -= n;
+    } while (count != 0);
+    return (res);
+  }
+
+  /**
+   * Interrupt service routine; transfer next byte of the current
+   * transaction or start the next transaction. Called by the TWI
+   * interrupt handler.
+   */
+  void isr()
+  {
+    switch (TW_STATUS) {
+    case TW_START:
+    case TW_REP_START:
+      // Fetch transaction header and send address
+      m_addr = m_buf[m_get];
+      m_len = m_buf[(m_get + 1) & MASK];
+      m_get = (m_get + 2) & MASK;
+      TWDR = (m_addr << 1) | TW_WRITE;
+      TWCR = _BV(TWINT) | _BV(TWEN) | _BV(TWIE);
+      return;
+    case TW_MT_SLA_ACK:
+    case TW_MT_DATA_ACK:
+      // Send next data byte
+      if (m_len != 0) {
+	TWDR = m_buf[m_get];
+	m_get = (m_get + 1) & MASK;
+	m_len -= 1;
+	TWCR = _BV(TWINT) | _BV(TWEN) | _BV(TWIE);
+	return;
+      }
+      break;
+    default:
+      // Not acknowledged, arbitration lost or bus error; drop
+      m_get = (m_get + m_len) & MASK;
+      m_len = 0;
+    }
+
+    // Stop and start next transaction if any
+    if (m_get != m_put) {
+      TWCR = _BV(TWINT) | _BV(TWEN) | _BV(TWIE) | _BV(TWSTO) | _BV(TWSTA);
+    }
+    else {
+      TWCR = _BV(TWINT) | _BV(TWEN) | _BV(TWSTO);
+      m_busy = false;
+    }
+  }
+
+  /** Bus instance for interrupt handler. */
+  static TWI_Async* s_twi;
+
+protected:
+  /** Ring buffer index mask. */
+  static const uint8_t MASK = BUFFER_MAX - 1;
+
+  /**
+   * Return number of free bytes in ring buffer.
+   * @return bytes.
+   */
+  uint8_t available() const
+  {
+    return ((m_get - m_put - 1) & MASK);
+  }
+
+  /**
+   * Start transfer if the bus is not busy.
+   */
+  void start()
+  {
+    uint8_t sreg = SREG;
+    cli();
+    if (!m_busy) {
+      m_busy = true;
+      while (TWCR & _BV(TWSTO));
+      TWCR = _BV(TWINT) | _BV(TWEN) | _BV(TWIE) | _BV(TWSTA);
+    }
+    SREG = sreg;
+  }
+
+  /**
+   * Issue given command (with interrupt flag and enable) and wait
+   * for completion. Returns true(1) if the status is as given
+   * otherwise false(0).
+   * @param[in] cmd command bits.
+   * @param[in] status expected status.
+   * @return bool.
+   */
+  bool command(uint8_t cmd, uint8_t status)
+  {
+    TWCR = _BV(TWINT) | _BV(TWEN) | cmd;
+    while (!(TWCR & _BV(TWINT)));
+    return (TW_STATUS == status);
+  }
+
+  uint8_t m_buf[BUFFER_MAX];	//!< Ring buffer; address, count, data.
+  volatile uint8_t m_put;	//!< Ring buffer put index.
+  volatile uint8_t m_get;	//!< Ring buffer get index.
+  uint8_t m_addr;		//!< Current transaction device address.
+  uint8_t m_len;		//!< Current transaction remaining bytes.
+  volatile bool m_busy;		//!< Transfer in progress.
+};
+
+/**
+ * PCF8574 based HD44780 adapter with background transfer on an
+ * interrupt-driven TWI bus. Adds the idle query to the adapter.
+ * @param[in] ADAPTER PCF8574 based adapter class; MJKDZ, GY_IICLCD
+ * or DFRobot_IIC.
+ */
+template<typename ADAPTER>
+class Async : public ADAPTER {
+public:
+  /**
+   * Construct adapter on given interrupt-driven TWI bus with the
+   * default sub-address.
+   * @param[in] twi bus.
+   */
+  Async(TWI_Async& twi) :
+    ADAPTER(twi),
+    m_bus(twi)
+  {}
+
+  /**
+   * Construct adapter on given interrupt-driven TWI bus with given
+   * sub-address (A0..A2).
+   * @param[in] twi bus.
+   * @param[in] subaddr sub-address (0..7).
+   */
+  Async(TWI_Async& twi, uint8_t subaddr) :
+    ADAPTER(twi, subaddr),
+    m_bus(twi)
+  {}
+
+  /**
+   * @override{HD44780::Adapter}
+   * Returns true(1) if the bus has transferred all written data
+   * otherwise false(0).
+   * @return bool.
+   */
+  virtual bool is_idle()
+  {
+    return (m_bus.is_idle());
+  }
+
+protected:
+  TWI_Async& m_bus;		//!< Interrupt-driven bus.
+};
+};
+
+#if defined(LCD_TWI_ASYNC_IMPL)
+LCD::TWI_Async* LCD::TWI_Async::s_twi = NULL;
+
+ISR(TWI_vect)
+{
+  LCD::TWI_Async::s_twi->isr();
+}
+#endif
+#endif
+#endif
@@ -0,0 +1,406 @@
+/**
+ * @file LCD/Adapter/TWI_Scheduler.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef LCD_ADAPTER_TWI_SCHEDULER_H
+#define LCD_ADAPTER_TWI_SCHEDULER_H
+
+#include "LCD.h"
+#include "Driver/HD44780.h"
+#include "TWI.h"
+
+/**
+ * Shared TWI bus scheduler for several HD44780 displays with PCF8574
+ * based adapters. Each display writes to its own queue and the
+ * scheduler interleaves the queued transfers on the bus. Execution
+ * times (e.g. display clear) are recorded in the queue as holds;
+ * the display is not written until the hold has passed while the
+ * other displays are served. The queues are served round-robin with
+ * one transaction per run.
+ *
+ * The scheduler runs when run() is called, when a display waits for
+ * its queue and when a queue is full. The sketch should call run()
+ * frequently, or flush() to wait for all queues.
+ *
+ * @section Example
+ * @code
+ * Hardware::TWI twi(400000UL);
+ * LCD::TWI_Scheduler scheduler(twi);
+ * LCD::TWI_Scheduler::Queue q0(scheduler);
+ * LCD::TWI_Scheduler::Queue q1(scheduler);
+ * LCD::Scheduled<LCD::MJKDZ> port0(q0, 0);
+ * LCD::Scheduled<LCD::MJKDZ> port1(q1, 1);
+ * HD44780 lcd0(port0);
+ * HD44780 lcd1(port1);
+ * ...
+ * lcd0.display_clear();
+ * lcd1.print(value);
+ * scheduler.run();
+ * @endcode
+ */
+namespace LCD {
+class TWI_Scheduler {
+public:
+  /** Max number of data bytes per transaction. */
+  static const uint8_t DATA_MAX = 32;
+
+  /**
+   * Display queue; written by the display adapter as its TWI bus.
+   * Write transactions are queued and transferred by the scheduler.
+   * Read waits for the queue and is performed directly on the bus.
+   */
+  class Queue : public ::TWI {
+  public:
+    /** Size of ring buffer; power of two. */
+    static const uint8_t QUEUE_MAX = 64;
+
+    /**
+     * Construct queue and attach to given scheduler.
+     * @param[in] scheduler bus scheduler.
+     */
+    Queue(TWI_Scheduler& scheduler) :
+      ::TWI(),
+      m_scheduler(scheduler),
+      m_next(NULL),
+      m_put(0),
+      m_get(0),
+      m_held(false),
+      m_hold(0),
+      m_start(0)
+    {
+      scheduler.attach(this);
+    }
+
+    /**
+     * Returns true(1) if all queued transactions have been
+     * transferred otherwise false(0). Runs the scheduler.
+     * @return bool.
+     */
+    bool is_idle()
+    {
+      if (m_get != m_put) m_scheduler.run();
+      return (m_get == m_put);
+    }
+
+    /**
+     * Wait for all queued transactions to be transferred.
+     */
+    void flush()
+    {
+      while (!is_idle());
+    }
+
+    /**
+     * Queue hold for given execution time; the following
+     * transactions are transferred when the time has passed after
+     * the preceding transactions.
+     * @param[in] us execution time in micro-seconds.
+     */
+    void hold(uint16_t us)
+    {
+      reserve(3);
+      put(0);
+      put(us);
+      put(us >> 8);
+    }
+
+    /**
+     * @override{TWI}
+     * Read given number of bytes from device with given address into
+     * given buffer. Waits for queued transactions. Returns number of
+     * bytes read or negative error code.
+     * @param[in] addr device address.
+     * @param[in] buf pointer to buffer.
+     * @param[in] count number of bytes to read.
+     * @return number of bytes or negative error code.
+     */
+    virtual int read(uint8_t addr, void* buf, size_t count)
+    {
+      flush();
+      return (m_scheduler.m_twi.read(addr, buf, count));
+    }
+
+    /**
+     * @override{TWI}
+     * Queue given buffer for device with given address. Buffers
+     * larger than DATA_MAX are queued as several transactions. Runs
+     * the scheduler while the queue is full. Returns number of bytes.
+     * @param[in] addr device address.
+     * @param[in] buf pointer to buffer.
+     * @param[in] count number of bytes to write.
+     * @return number of bytes.
+     */
+    virtual int write(uint8_t addr, const void* buf, size_t count)
+    {
+      const uint8_t* bp = (const uint8_t*) buf;
+      size_t res = count;
+      while (count != 0) {
+	uint8_t n = (count > DATA_MAX ? DATA_MAX : count);
+	reserve(n + 2);
+	put(n);
+	put(addr);
+	for (uint8_t i = 0; i < n; i++) put(*bp++);
+	count -= n;
+      }
+      return (res);
+    }
+
+  protected:
+    friend class TWI_Scheduler;
+
+    /** Ring buffer index mask. */
+    static const uint8_t MASK = QUEUE_MAX - 1;
+
+    /**
+     * Return number of free bytes in ring buffer.
+     * @return bytes.
+     */
+    uint8_t available() const
+    {
+      return ((m_get - m_put - 1) & MASK);
+    }
+
+    /**
+     * Transfer from the queue until given number of bytes are free in
+     * the ring buffer. The scheduler serves the other queues while
+     * the queue is held.
+     * @param[in] size number of bytes.
+     */
+    void reserve(uint8_t size)
+    {
+      while (available() < size)
+	if (!transfer(m_scheduler.m_twi)) m_scheduler.run();
+    }
+
+    /**
+     * Put given byte into ring buffer.
+     * @param[in] data byte.
+     */
+    void put(uint8_t data)
+    {
+      m_buf[m_put] = data;
+      m_put = (m_put + 1) & MASK;
+    }
+
+    /**
+     * Return byte at given offset from the ring buffer get index.
+     * @param[in] offset from get index.
+     * @return byte.
+     */
+    uint8_t peek(uint8_t offset) const
+    {
+      return (m_buf[(m_get + offset) & MASK]);
+    }
+
+    /**
+     * Start hold if the next queued record is a hold. Returns true(1)
+     * if started otherwise false(0).
+     * @return bool.
+     */
+    bool start_hold()
+    {
+      if (m_get == m_put || peek(0) != 0) return (false);
+      uint16_t us = peek(1) | (peek(2) << 8);
+      m_get = (m_get + 3) & MASK;
+      m_start = micros();
+      m_hold = us;
+      m_held = true;
+      return (true);
+    }
+
+    /**
+     * Returns true(1) if the queue is held otherwise false(0). The
+     * hold is released on the first check after the execution time.
+     * The elapsed time is unsigned; a check long after the hold
+     * (micros() wrap) releases it or holds at most the execution time.
+     * @return bool.
+     */
+    bool is_held()
+    {
+      if (!m_held) return (false);
+      if ((uint32_t) (micros() - m_start) < m_hold) return (true);
+      m_held = false;
+      return (false);
+    }
+
+    /**
+     * Transfer the next queued transactions on the given bus if the
+     * queue is not held. Consecutive transactions to the same device
+     * are merged up to DATA_MAX bytes. A following hold is started
+     * directly after the transfer. Returns true(1) if a transfer was
+     * made otherwise false(0).
+     * @param[in] twi bus.
+     * @return bool.
+     */
+    bool transfer(::TWI& twi)
+    {
+      if (is_held()) return (false);
+      while (start_hold())
+	if (is_held()) return (false);
+      if (m_get == m_put) return (false);
+      uint8_t buf[DATA_MAX];
+      uint8_t addr = peek(1);
+      uint8_t len = 0;
+      do {
+	uint8_t n = peek(0);
+	m_get = (m_get + 2) & MASK;
+	for (uint8_t i = 0; i < n; i++) {
+	  buf[len++] = m_buf[m_get];
+	  m_get = (m_get + 1) & MASK;
+	}
+      } while (m_get != m_put
+	       && peek(0) != 0
+	       && peek(1) == addr
+	       && len + peek(0) <= DATA_MAX);
+      twi.write(addr, buf, len);
+      start_hold();
+      return (true);
+    }
+
+    TWI_Scheduler& m_scheduler;	//!< Bus scheduler.
+    Queue* m_next;		//!< Next queue in scheduler list.
+    uint8_t m_buf[QUEUE_MAX];	//!< Ring buffer; count, address, data or hold.
+    uint8_t m_put;		//!< Ring buffer put index.
+    uint8_t m_get;		//!< Ring buffer get index.
+    bool m_held;		//!< Hold started and not yet passed.
+    uint16_t m_hold;		//!< Hold execution time (us).
+    uint32_t m_start;		//!< Start of hold (us).
+  };
+
+  /**
+   * Construct scheduler for given bus.
+   * @param[in] twi bus.
+   */
+  TWI_Scheduler(::TWI& twi) :
+    m_twi(twi),
+    m_queue(NULL),
+    m_current(NULL)
+  {}
+
+  /**
+   * Transfer the next queued transactions of the first queue, in
+   * round-robin order, that is not empty or held. Returns true(1) if
+   * a transfer was made otherwise false(0).
+   * @return bool.
+   */
+  bool run()
+  {
+    Queue* queue = m_current;
+    for (Queue* q = m_queue; q != NULL; q = q->m_next) {
+      queue = (queue == NULL || queue->m_next == NULL) ? m_queue : queue->m_next;
+      if (queue->transfer(m_twi)) {
+	m_current = queue;
+	return (true);
+      }
+    }
+    return (false);
+  }
+
+  /**
+   * Returns true(1) if all queues are empty otherwise false(0).
+   * @return bool.
+   */
+  bool is_idle() const
+  {
+    for (Queue* queue = m_queue; queue != NULL; queue = queue->m_next)
+      if (queue->m_get != queue->m_put) return (false);
+    return (true);
+  }
+
+  /**
+   * Run scheduler until all queues are empty.
+   */
+  void flush()
+  {
+    while (!is_idle()) run();
+  }
+
+protected:
+  /**
+   * Attach given queue to the scheduler.
+   * @param[in] queue to attach.
+   */
+  void attach(Queue* queue)
+  {
+    queue->m_next = m_queue;
+    m_queue = queue;
+  }
+
+  ::TWI& m_twi;			//!< Shared bus.
+  Queue* m_queue;		//!< List of queues.
+  Queue* m_current;		//!< Last served queue.
+};
+
+/**
+ * PCF8574 based HD44780 adapter on a scheduled shared TWI bus.
+ * Writes to the display queue and holds the queue for the execution
+ * times instead of delaying.
+ * @param[in] ADAPTER PCF8574 based adapter class; MJKDZ, GY_IICLCD
+ * or DFRobot_IIC.
+ */
+template<typename ADAPTER>
+class Scheduled : public ADAPTER {
+public:
+  /**
+   * Construct adapter on given display queue with the default
+   * sub-address.
+   * @param[in] queue display queue.
+   */
+  Scheduled(TWI_Scheduler::Queue& queue) :
+    ADAPTER(queue),
+    m_queue(queue)
+  {}
+
+  /**
+   * Construct adapter on given display queue with given sub-address
+   * (A0..A2).
+   * @param[in] queue display queue.
+   * @param[in] subaddr sub-address (0..7).
+   */
+  Scheduled(TWI_Scheduler::Queue& queue, uint8_t subaddr) :
+    ADAPTER(queue, subaddr),
+    m_queue(queue)
+  {}
+
+  /**
+   * @override{HD44780::Adapter}
+   * Returns true(1) if the queue has been transferred otherwise
+   * false(0). Runs the scheduler.
+   * @return bool.
+   */
+  virtual bool is_idle()
+  {
+    return (m_queue.is_idle());
+  }
+
+  /**
+   * @override{HD44780::Adapter}
+   * Record hold for given execution time in the queue.
+   * @param[in] us execution time in micro-seconds.
+   * @return true(1).
+   */
+  virtual bool hold(uint16_t us)
+  {
+    m_queue.hold(us);
+    return (true);
+  }
+
+protected:
+  TWI_Scheduler::Queue& m_queue; //!< Display queue.
+};
+};
+#endif
@@ -0,0 +1,430 @@
+/**
+ * @file LCD/Device/Canvas.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef LCD_DEVICE_CANVAS_H
+#define LCD_DEVICE_CANVAS_H
+
+#include "LCD.h"
+#include "Driver/HD44780.h"
+
+/**
+ * Virtual text canvas in front of a physical display (LCD::Device).
+ * Text is written to a canvas of COLS x ROWS characters. The lines
+ * are kept in a ring buffer; new-line on the last line scrolls the
+ * canvas and the oldest line is dropped. A viewport of WIDTH x HEIGHT
+ * characters (the physical display size) may be panned over the
+ * canvas. The viewport follows the cursor until it is explicitly
+ * set with viewport_set().
+ *
+ * The display is updated with flush(). A shadow of the display
+ * content is kept and only the changed part of each line is
+ * written; the display is never cleared when scrolling. When
+ * constructed with an HD44780 display with at most two lines, no
+ * split line (16x1), and a canvas of at most 40 columns the complete
+ * canvas line is kept in the controller display data memory (DDRAM)
+ * and horizontal panning is performed with the controller display
+ * shift.
+ *
+ * The canvas requires COLS x ROWS bytes for the lines and
+ * max(COLS, WIDTH) x HEIGHT bytes for the shadow.
+ *
+ * @param[in] COLS canvas width (characters per line, at least WIDTH).
+ * @param[in] ROWS canvas height (lines, including scrollback, at
+ * least HEIGHT).
+ * @param[in] WIDTH viewport/display width (characters per line).
+ * @param[in] HEIGHT viewport/display height (lines).
+ *
+ * @section Example
+ * @code
+ * LCD::Canvas<40,16,16,2> log(lcd);
+ * ...
+ * log.begin();
+ * ...
+ * log.print(F("\nsensor: "));
+ * log.print(value);
+ * log.flush();
+ * ...
+ * log.viewport_set(x, y);
+ * log.flush();
+ * @endcode
+ */
+namespace LCD {
+template<uint8_t COLS, uint8_t ROWS, uint8_t WIDTH, uint8_t HEIGHT>
+class Canvas : public LCD::Device {
+  static_assert(COLS >= WIDTH && ROWS >= HEIGHT,
+		"LCD::Canvas: canvas smaller than viewport");
+public:
+  /**
+   * Construct canvas in front of given display.
+   * @param[in] dev display device driver.
+   */
+  Canvas(LCD::Device& dev) :
+    LCD::Device(),
+    m_dev(&dev),
+    m_hd(NULL)
+  {
+    clear();
+  }
+
+  /**
+   * Construct canvas in front of given HD44780 display. Horizontal
+   * panning uses the controller display shift if the display has at
+   * most two lines without split and the canvas at most 40 columns.
+   * The display shift does not pan the visible window of a split
+   * line display.
+   * @param[in] dev display device driver.
+   */
+  Canvas(HD44780& dev) :
+    LCD::Device(),
+    m_dev(&dev),
+    m_hd((dev.HEIGHT <= 2) && (dev.split() == dev.WIDTH)
+	 && (COLS <= DDRAM_COLS) ? &dev : NULL)
+  {
+    clear();
+  }
+
+  /**
+   * Set viewport position in canvas. The position is limited so that
+   * the viewport is within the canvas. The viewport will no longer
+   * follow the cursor. The display is updated on the next flush.
+   * @param[in] x column.
+   * @param[in] y line.
+   */
+  void viewport_set(uint8_t x, uint8_t y)
+  {
+    m_vx = (x > COLS - WIDTH ? COLS - WIDTH : x);
+    m_vy = (y > ROWS - HEIGHT ? ROWS - HEIGHT : y);
+    m_follow = false;
+  }
+
+  /**
+   * Let the viewport follow the cursor (default).
+   */
+  void viewport_follow()
+  {
+    m_follow = true;
+  }
+
+  /**
+   * Get viewport column.
+   * @return column.
+   */
+  uint8_t viewport_x() const
+    __attribute__((always_inline))
+  {
+    return (m_vx);
+  }
+
+  /**
+   * Get viewport line.
+   * @return line.
+   */
+  uint8_t viewport_y() const
+    __attribute__((always_inline))
+  {
+    return (m_vy);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Start display and clear canvas. Returns true if successful
+   * otherwise false.
+   * @return bool.
+   */
+  virtual bool begin()
+  {
+    clear();
+    return (m_dev->begin());
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Stop display.
+   * @return bool.
+   */
+  virtual bool end()
+  {
+    return (m_dev->end());
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Turn display backlight on.
+   */
+  virtual void backlight_on()
+  {
+    m_dev->backlight_on();
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Turn display backlight off.
+   */
+  virtual void backlight_off()
+  {
+    m_dev->backlight_off();
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Set display contrast level.
+   * @param[in] level to set.
+   */
+  virtual void display_contrast(uint8_t level)
+  {
+    m_dev->display_contrast(level);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Turn display on.
+   */
+  virtual void display_on()
+  {
+    m_dev->display_on();
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Turn display off.
+   */
+  virtual void display_off()
+  {
+    m_dev->display_off();
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Clear canvas, move cursor and viewport to home. The display is
+   * updated on the next flush.
+   */
+  virtual void display_clear()
+  {
+    LCD_DEVICE_PROBE(STAT_DISPLAY_CLEAR, 0);
+    invalidate();
+    memset(m_buf, ' ', sizeof(m_buf));
+    m_top = 0;
+    m_x = 0;
+    m_y = 0;
+    m_vx = 0;
+    m_vy = 0;
+    m_follow = true;
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Get canvas width (characters per line).
+   * @return width.
+   */
+  virtual uint8_t width() const
+  {
+    return (COLS);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Get canvas height (lines).
+   * @return height.
+   */
+  virtual uint8_t height() const
+  {
+    return (ROWS);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Set cursor position in canvas.
+   * @param[in] x.
+   * @param[in] y.
+   */
+  virtual void cursor_set(uint8_t x, uint8_t y)
+  {
+    LCD_DEVICE_PROBE(STAT_CURSOR_SET, 0);
+    if (x >= COLS) x = 0;
+    if (y >= ROWS) y = 0;
+    m_x = x;
+    m_y = y;
+  }
+
+  /**
+   * @override{Arduino::Print}
+   * Write character to canvas. Handles carriage-return, line-feed,
+   * backspace, alert, horizontal tab and form-feed. New-line on the
+   * last line scrolls the canvas. Returns number of characters(1) or
+   * zero(0) on error.
+   * @param[in] c character to write.
+   * @return number of characters written(1) or zero(0) for error.
+   */
+  virtual size_t write(uint8_t c)
+  {
+    LCD_DEVICE_PROBE(STAT_WRITE, 1);
+    // Check for escape sequence
+    if (escape(c)) return (1);
+
+    // Check for special characters
+    if (c < ' ') {
+      switch (c) {
+      case '\a': // Alert: invert text mode
+	m_mode = ~m_mode;
+	return (1);
+      case '\b': // Back-space: move cursor back one step (if possible)
+	cursor_set(m_x - 1, m_y);
+	line(m_y)[m_x] = ' ';
+	return (1);
+      case '\f': // Form-feed: clear the canvas
+	display_clear();
+	return (1);
+      case '\n': // New-line: clear line, scroll on last line
+	if (m_y == ROWS - 1) {
+	  m_top = (m_top == ROWS - 1 ? 0 : m_top + 1);
+	  cursor_set(0, m_y);
+	}
+	else {
+	  cursor_set(0, m_y + 1);
+	}
+	memset(line(m_y), ' ', COLS);
+	return (1);
+      case '\r': // Carriage-return: move to start of line
+	cursor_set(0, m_y);
+	return (1);
+      case '\t': // Horizontal tab
+	{
+	  uint8_t x = m_x + m_tab - (m_x % m_tab);
+	  if (x >= COLS) return (write('\n'));
+	  cursor_set(x, m_y);
+	}
+	return (1);
+      default:
+	return (0);
+      }
+    }
+
+    // Write character
+    if (m_x == COLS) write('\n');
+    line(m_y)[m_x] = c;
+    m_x += 1;
+    return (1);
+  }
+
+  /**
+   * @override{Arduino::Print}
+   * Update display with the canvas content in the viewport. Only the
+   * changed part of each display line is written, with a single
+   * cursor position and buffer write per line, in one output batch.
+   */
+  virtual void flush()
+  {
+    LCD_DEVICE_PROBE(STAT_FLUSH, 0);
+    if (m_follow) follow();
+    const uint8_t cols = (m_hd != NULL ? COLS : WIDTH);
+    const uint8_t x0 = (m_hd != NULL ? 0 : m_vx);
+    m_dev->begin_batch();
+    for (uint8_t y = 0; y < HEIGHT; y++) {
+      const uint8_t* src = line(m_vy + y) + x0;
+      uint8_t* dest = m_shadow[y];
+      uint8_t first = 0;
+      while (first < cols && src[first] == dest[first]) first++;
+      if (first == cols) continue;
+      uint8_t last = cols;
+      while (src[last - 1] == dest[last - 1]) last--;
+      uint8_t n = last - first;
+      memcpy(&dest[first], &src[first], n);
+      if (m_hd != NULL) {
+	m_hd->ddram_write(first, y, &src[first], n);
+      }
+      else {
+	m_dev->cursor_set(first, y);
+	m_dev->write(&src[first], n);
+      }
+    }
+    if (m_hd != NULL) pan();
+    m_dev->end_batch();
+  }
+
+protected:
+  /** Number of DDRAM columns per line for two line HD44780. */
+  static const uint8_t DDRAM_COLS = 40;
+
+  /** Size of display shadow line. */
+  static const uint8_t SHADOW_COLS = (COLS > WIDTH ? COLS : WIDTH);
+
+  /**
+   * Return pointer to given canvas line in ring buffer.
+   * @param[in] y canvas line.
+   * @return pointer to line.
+   */
+  uint8_t* line(uint8_t y)
+  {
+    uint8_t ix = m_top + y;
+    if (ix >= ROWS) ix -= ROWS;
+    return (m_buf[ix]);
+  }
+
+  /**
+   * Clear canvas and display shadow. The shadow is the content of
+   * the display after begin().
+   */
+  void clear()
+  {
+    display_clear();
+    memset(m_shadow, ' ', sizeof(m_shadow));
+    m_shift = 0;
+  }
+
+  /**
+   * Move viewport so that the cursor is visible.
+   */
+  void follow()
+  {
+    uint8_t x = (m_x < COLS ? m_x : COLS - 1);
+    if (x < m_vx) m_vx = x;
+    else if (x >= m_vx + WIDTH) m_vx = x - WIDTH + 1;
+    if (m_y < m_vy) m_vy = m_y;
+    else if (m_y >= m_vy + HEIGHT) m_vy = m_y - HEIGHT + 1;
+  }
+
+  /**
+   * Shift HD44780 display to the viewport column. The shortest
+   * direction in the circular DDRAM line is used.
+   */
+  void pan()
+  {
+    uint8_t n = (m_vx + DDRAM_COLS - m_shift) % DDRAM_COLS;
+    if (n == 0) return;
+    if (n <= DDRAM_COLS / 2) {
+      while (n--) m_hd->display_scroll_left();
+    }
+    else {
+      n = DDRAM_COLS - n;
+      while (n--) m_hd->display_scroll_right();
+    }
+    m_shift = m_vx;
+  }
+
+  LCD::Device* m_dev;		//!< Display device driver.
+  HD44780* m_hd;		//!< HD44780 with hardware pan or NULL.
+  uint8_t m_buf[ROWS][COLS];	//!< Canvas lines (ring buffer).
+  uint8_t m_shadow[HEIGHT][SHADOW_COLS]; //!< Display content.
+  uint8_t m_top;		//!< Ring buffer index of first line.
+  uint8_t m_vx;			//!< Viewport column.
+  uint8_t m_vy;			//!< Viewport line.
+  uint8_t m_shift;		//!< HD44780 display shift.
+  bool m_follow;		//!< Viewport follows cursor.
+};
+};
+#endif
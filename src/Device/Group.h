@@ -0,0 +1,143 @@
+/**
+ * @file LCD/Device/Group.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef LCD_DEVICE_GROUP_H
+#define LCD_DEVICE_GROUP_H
+
+#include "LCD.h"
+
+/**
+ * Display group; start several displays (LCD::Device) with the
+ * initialization sequences interleaved. All displays are started with
+ * begin_async() and polled until ready. While one display waits for a
+ * deadline the others may run their initialization steps. The total
+ * start time is close to the start time of the slowest display.
+ *
+ * @param[in] DEVICE_MAX max number of displays in group (Default 4).
+ *
+ * @section Example
+ * @code
+ * LCD::Group<3> displays;
+ * ...
+ * displays.attach(lcd1);
+ * displays.attach(lcd2);
+ * displays.attach(nokia);
+ * displays.begin();
+ * @endcode
+ */
+namespace LCD {
+template<uint8_t DEVICE_MAX = 4>
+class Group {
+public:
+  /**
+   * Construct empty display group.
+   */
+  Group() :
+    m_devices(0)
+  {}
+
+  /**
+   * Attach given display to group. Returns true if successful
+   * otherwise false (too many displays).
+   * @param[in] dev display device driver.
+   * @return bool.
+   */
+  bool attach(LCD::Device& dev)
+  {
+    if (m_devices == DEVICE_MAX) return (false);
+    m_dev[m_devices++] = &dev;
+    return (true);
+  }
+
+  /**
+   * Get number of displays in group.
+   * @return number of displays.
+   */
+  uint8_t devices() const
+    __attribute__((always_inline))
+  {
+    return (m_devices);
+  }
+
+  /**
+   * Get display with given index.
+   * @param[in] ix display index.
+   * @return display device driver.
+   */
+  LCD::Device& operator[](uint8_t ix)
+    __attribute__((always_inline))
+  {
+    return (*m_dev[ix]);
+  }
+
+  /**
+   * Start all displays and wait until all are ready. Returns true if
+   * all displays were started otherwise false.
+   * @return bool.
+   */
+  bool begin()
+  {
+    bool res = begin_async();
+    while (!poll());
+    return (res);
+  }
+
+  /**
+   * Start all displays without blocking. The start sequences are
+   * completed by calling poll(). Returns true if all displays were
+   * started otherwise false.
+   * @return bool.
+   */
+  bool begin_async()
+  {
+    bool res = true;
+    for (uint8_t ix = 0; ix < m_devices; ix++)
+      res = m_dev[ix]->begin_async() && res;
+    return (res);
+  }
+
+  /**
+   * Run pending start sequence steps of all displays. Returns true
+   * if all displays are ready otherwise false.
+   * @return bool.
+   */
+  bool poll()
+  {
+    bool res = true;
+    for (uint8_t ix = 0; ix < m_devices; ix++)
+      res = m_dev[ix]->poll() && res;
+    return (res);
+  }
+
+  /**
+   * Returns true if all displays are ready otherwise false.
+   * @return bool.
+   */
+  bool ready()
+  {
+    for (uint8_t ix = 0; ix < m_devices; ix++)
+      if (!m_dev[ix]->ready()) return (false);
+    return (true);
+  }
+
+protected:
+  LCD::Device* m_dev[DEVICE_MAX]; //!< Displays in group.
+  uint8_t m_devices;		//!< Number of displays.
+};
+};
+#endif
@@ -0,0 +1,509 @@
+/**
+ * @file LCD/Device/Mirror.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef LCD_DEVICE_MIRROR_H
+#define LCD_DEVICE_MIRROR_H
+
+#include "LCD.h"
+
+/**
+ * Multi-display device; text is written once to a logical screen
+ * buffer and mirrored to several attached displays (LCD::Device).
+ * Each display has its own dirty region, per line, and is flushed
+ * independently with flush(ix). The logical screen is clipped to the
+ * width and height of each display. Display control functions
+ * (backlight, display on/off, contrast) are forwarded directly.
+ * Text mode (inverse) is not mirrored.
+ *
+ * The mirror may also be used as a refresh scheduler, with one or
+ * more displays. Writes only update the logical screen and
+ * refresh() sends as many of the pending updates as fit within a
+ * given time budget, resuming where it left off on the next call.
+ * The write cost per character is measured for each display. The
+ * refresh rate may be limited with refresh_rate().
+ *
+ * @param[in] WIDTH logical screen width (characters per line).
+ * @param[in] HEIGHT logical screen height (lines).
+ * @param[in] DEVICE_MAX max number of attached displays (Default 2).
+ *
+ * @section Example
+ * @code
+ * LCD::Mirror<16,2> lcd;
+ * ...
+ * lcd.attach(panel);
+ * lcd.attach(cabinet);
+ * lcd.begin();
+ * ...
+ * lcd.print(F("Status: OK"));
+ * lcd.flush(0);
+ * ...
+ * lcd.flush(1);
+ * ...
+ * lcd.refresh_rate(20);
+ * ...
+ * lcd.print(value);
+ * lcd.refresh(500);
+ * @endcode
+ */
+namespace LCD {
+template<uint8_t WIDTH, uint8_t HEIGHT, uint8_t DEVICE_MAX = 2>
+class Mirror : public LCD::Device {
+public:
+  /**
+   * Construct multi-display device with empty logical screen.
+   */
+  Mirror() :
+    LCD::Device(),
+    m_devices(0),
+    m_next(0),
+    m_pending(false),
+    m_period(0),
+    m_start(0)
+  {
+    memset(m_buf, ' ', sizeof(m_buf));
+  }
+
+  /**
+   * Attach given display. The display geometry is clipped to the
+   * logical screen. Returns true if successful otherwise false
+   * (too many displays).
+   * @param[in] dev display device driver.
+   * @return bool.
+   */
+  bool attach(LCD::Device& dev)
+  {
+    if (m_devices == DEVICE_MAX) return (false);
+    display_t& display = m_display[m_devices++];
+    display.dev = &dev;
+    display.width = (dev.width() < WIDTH ? dev.width() : WIDTH);
+    display.height = (dev.height() < HEIGHT ? dev.height() : HEIGHT);
+    display.clear = true;
+    display.cost = COST_INIT;
+    touch(display);
+    return (true);
+  }
+
+  /**
+   * Get number of attached displays.
+   * @return number of displays.
+   */
+  uint8_t devices() const
+    __attribute__((always_inline))
+  {
+    return (m_devices);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Start all attached displays. The logical screen is written on
+   * the next flush. Returns true if all displays were started
+   * otherwise false.
+   * @return bool.
+   */
+  virtual bool begin()
+  {
+    bool res = true;
+    for (uint8_t ix = 0; ix < m_devices; ix++) {
+      display_t& display = m_display[ix];
+      res = display.dev->begin() && res;
+      display.clear = false;
+      touch(display);
+    }
+    return (res);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Stop all attached displays.
+   * @return true(1).
+   */
+  virtual bool end()
+  {
+    bool res = true;
+    for (uint8_t ix = 0; ix < m_devices; ix++)
+      res = m_display[ix].dev->end() && res;
+    return (res);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Turn backlight on for all displays.
+   */
+  virtual void backlight_on()
+  {
+    for (uint8_t ix = 0; ix < m_devices; ix++)
+      m_display[ix].dev->backlight_on();
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Turn backlight off for all displays.
+   */
+  virtual void backlight_off()
+  {
+    for (uint8_t ix = 0; ix < m_devices; ix++)
+      m_display[ix].dev->backlight_off();
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Set contrast level for all displays.
+   * @param[in] level to set.
+   */
+  virtual void display_contrast(uint8_t level)
+  {
+    for (uint8_t ix = 0; ix < m_devices; ix++)
+      m_display[ix].dev->display_contrast(level);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Turn all displays on.
+   */
+  virtual void display_on()
+  {
+    for (uint8_t ix = 0; ix < m_devices; ix++)
+      m_display[ix].dev->display_on();
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Turn all displays off.
+   */
+  virtual void display_off()
+  {
+    for (uint8_t ix = 0; ix < m_devices; ix++)
+      m_display[ix].dev->display_off();
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Clear logical screen and move cursor to home. The displays are
+   * cleared on the next flush.
+   */
+  virtual void display_clear()
+  {
+    LCD_DEVICE_PROBE(STAT_DISPLAY_CLEAR, 0);
+    invalidate();
+    memset(m_buf, ' ', sizeof(m_buf));
+    for (uint8_t ix = 0; ix < m_devices; ix++) {
+      display_t& display = m_display[ix];
+      display.clear = true;
+      memset(display.first, WIDTH, sizeof(display.first));
+      memset(display.last, 0, sizeof(display.last));
+    }
+    m_x = 0;
+    m_y = 0;
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Get logical screen width (characters per line).
+   * @return width.
+   */
+  virtual uint8_t width() const
+  {
+    return (WIDTH);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Get logical screen height (lines).
+   * @return height.
+   */
+  virtual uint8_t height() const
+  {
+    return (HEIGHT);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Set logical cursor position to given position.
+   * @param[in] x.
+   * @param[in] y.
+   */
+  virtual void cursor_set(uint8_t x, uint8_t y)
+  {
+    LCD_DEVICE_PROBE(STAT_CURSOR_SET, 0);
+    if (x >= WIDTH) x = 0;
+    if (y >= HEIGHT) y = 0;
+    m_x = x;
+    m_y = y;
+  }
+
+  /**
+   * @override{Arduino::Print}
+   * Write character to logical screen. Handles carriage-return,
+   * line-feed, backspace, alert, horizontal tab and form-feed.
+   * Characters equal to the current screen content are not marked
+   * for update. Returns number of characters(1) or zero(0) on error.
+   * @param[in] c character to write.
+   * @return number of characters written(1) or zero(0) for error.
+   */
+  virtual size_t write(uint8_t c)
+  {
+    LCD_DEVICE_PROBE(STAT_WRITE, 1);
+    // Check for escape sequence
+    if (escape(c)) return (1);
+
+    // Check for special characters
+    if (c < ' ') {
+      switch (c) {
+      case '\a': // Alert: invert text mode
+	m_mode = ~m_mode;
+	return (1);
+      case '\b': // Back-space: move cursor back one step (if possible)
+	cursor_set(m_x - 1, m_y);
+	put(' ');
+	return (1);
+      case '\f': // Form-feed: clear the display
+	display_clear();
+	return (1);
+      case '\n': // New-line: clear line
+	cursor_set(0, m_y + 1);
+	for (uint8_t x = 0; x < WIDTH; x++) {
+	  m_x = x;
+	  put(' ');
+	}
+	m_x = 0;
+	return (1);
+      case '\r': // Carriage-return: move to start of line
+	cursor_set(0, m_y);
+	return (1);
+      case '\t': // Horizontal tab
+	{
+	  uint8_t x = m_x + m_tab - (m_x % m_tab);
+	  uint8_t y = m_y + (x >= WIDTH);
+	  cursor_set(x, y);
+	}
+	return (1);
+      default:
+	return (0);
+      }
+    }
+
+    // Write character
+    if (m_x == WIDTH) write('\n');
+    put(c);
+    m_x += 1;
+    return (1);
+  }
+
+  /**
+   * Flush pending updates of the logical screen to the display with
+   * the given index. Each dirty line is written with a single
+   * cursor_set() and a single write(). Returns true if the display
+   * was updated otherwise false (no changes or illegal index).
+   * @param[in] ix display index.
+   * @return bool.
+   */
+  bool flush(uint8_t ix)
+  {
+    if (ix >= m_devices) return (false);
+    display_t& display = m_display[ix];
+    LCD::Device* dev = display.dev;
+    bool res = display.clear;
+    if (display.clear) {
+      dev->display_clear();
+      display.clear = false;
+    }
+    for (uint8_t y = 0; y < HEIGHT; y++) {
+      uint8_t first = display.first[y];
+      uint8_t last = display.last[y];
+      display.first[y] = WIDTH;
+      display.last[y] = 0;
+      if (y >= display.height) continue;
+      if (last > display.width) last = display.width;
+      if (first >= last) continue;
+      dev->cursor_set(first, y);
+      dev->write((const uint8_t*) &m_buf[y][first], last - first);
+      res = true;
+    }
+    return (res);
+  }
+
+  /**
+   * Set max refresh rate for refresh(). Zero(0) for no limit
+   * (default).
+   * @param[in] hz max number of refresh rounds per second.
+   */
+  void refresh_rate(uint8_t hz)
+  {
+    m_period = (hz == 0 ? 0 : 1000000UL / hz);
+  }
+
+  /**
+   * Send pending updates of the logical screen to the displays within
+   * the given time budget. Dirty lines are written in parts if
+   * needed; the next call continues where this call stopped. A new
+   * refresh round is not started until the refresh period has
+   * elapsed. At least one character is written per call if there are
+   * pending updates. A pending display clear is only performed at the
+   * start of a call. Returns true if all displays are up to date
+   * otherwise false.
+   * @param[in] budget_us time budget in micro-seconds.
+   * @return bool.
+   */
+  bool refresh(uint32_t budget_us)
+  {
+    uint32_t start = micros();
+    if (!m_pending) {
+      if ((m_period != 0) && (start - m_start < m_period)) {
+	for (uint8_t ix = 0; ix < m_devices; ix++)
+	  if (is_dirty(ix)) return (false);
+	return (true);
+      }
+      m_start = start;
+      m_pending = true;
+    }
+    bool progress = false;
+    for (uint8_t i = 0; i < m_devices; i++) {
+      uint8_t ix = m_next;
+      display_t& display = m_display[ix];
+      LCD::Device* dev = display.dev;
+      if (display.clear) {
+	if (progress) return (false);
+	dev->display_clear();
+	display.clear = false;
+	progress = true;
+      }
+      for (uint8_t y = 0; y < display.height; y++) {
+	uint8_t first = display.first[y];
+	uint8_t last = display.last[y];
+	if (last > display.width) last = display.width;
+	if (first >= last) continue;
+	uint32_t now = micros();
+	uint32_t used = now - start;
+	uint32_t n = (used < budget_us ? (budget_us - used) / display.cost : 0);
+	if (n <= 1) {
+	  if (progress) return (false);
+	  n = 2;
+	}
+	n -= 1;
+	if (n > (uint32_t) (last - first)) n = last - first;
+	dev->cursor_set(first, y);
+	dev->write((const uint8_t*) &m_buf[y][first], n);
+	uint16_t cost = (micros() - now) / (n + 1);
+	display.cost = (3 * display.cost + cost + 3) / 4;
+	progress = true;
+	if (first + n < last) {
+	  display.first[y] = first + n;
+	  return (false);
+	}
+	display.first[y] = WIDTH;
+	display.last[y] = 0;
+      }
+      m_next = (ix + 1 == m_devices ? 0 : ix + 1);
+    }
+    m_pending = false;
+    return (true);
+  }
+
+  /**
+   * @override{Arduino::Print}
+   * Flush pending updates to all displays.
+   */
+  virtual void flush()
+  {
+    LCD_DEVICE_PROBE(STAT_FLUSH, 0);
+    for (uint8_t ix = 0; ix < m_devices; ix++) flush(ix);
+  }
+
+  /**
+   * Check if the display with the given index has pending updates.
+   * @param[in] ix display index.
+   * @return bool.
+   */
+  bool is_dirty(uint8_t ix) const
+  {
+    if (ix >= m_devices) return (false);
+    const display_t& display = m_display[ix];
+    if (display.clear) return (true);
+    for (uint8_t y = 0; y < display.height; y++)
+      if (display.first[y] < display.last[y]
+	  && display.first[y] < display.width)
+	return (true);
+    return (false);
+  }
+
+protected:
+  /** Initial write cost per character (us). */
+  static const uint16_t COST_INIT = 64;
+
+  /** Attached display and dirty region per line. */
+  struct display_t {
+    LCD::Device* dev;		//!< Display device driver.
+    uint8_t width;		//!< Clipped width.
+    uint8_t height;		//!< Clipped height.
+    bool clear;			//!< Clear display on next flush.
+    uint16_t cost;		//!< Write cost per character (us).
+    uint8_t first[HEIGHT];	//!< First dirty position per line.
+    uint8_t last[HEIGHT];	//!< Last dirty position (exclusive).
+  };
+
+  /**
+   * Put character at current cursor position in logical screen and
+   * mark position for update if changed.
+   * @param[in] c character.
+   */
+  void put(uint8_t c)
+  {
+    uint8_t& cell = m_buf[m_y][m_x];
+    if (cell == c) return;
+    cell = c;
+    for (uint8_t ix = 0; ix < m_devices; ix++)
+      mark(m_display[ix], m_x, m_y);
+  }
+
+  /**
+   * Mark given position in given display for update.
+   * @param[in] display.
+   * @param[in] x position.
+   * @param[in] y position.
+   */
+  static void mark(display_t& display, uint8_t x, uint8_t y)
+  {
+    if (x < display.first[y]) display.first[y] = x;
+    if (x >= display.last[y]) display.last[y] = x + 1;
+  }
+
+  /**
+   * Mark all non-space characters of the logical screen for update
+   * in given display. The display is assumed to be cleared.
+   * @param[in] display.
+   */
+  void touch(display_t& display)
+  {
+    for (uint8_t y = 0; y < HEIGHT; y++) {
+      display.first[y] = WIDTH;
+      display.last[y] = 0;
+      for (uint8_t x = 0; x < WIDTH; x++)
+	if (m_buf[y][x] != ' ') mark(display, x, y);
+    }
+  }
+
+  uint8_t m_buf[HEIGHT][WIDTH];	//!< Logical screen.
+  display_t m_display[DEVICE_MAX]; //!< Attached displays.
+  uint8_t m_devices;		//!< Number of attached displays.
+  uint8_t m_next;		//!< Next display to refresh.
+  bool m_pending;		//!< Refresh round in progress.
+  uint32_t m_period;		//!< Min refresh period (us).
+  uint32_t m_start;		//!< Start of refresh round (us).
+};
+};
+#endif
@@ -25,7 +25,10 @@
  * LCD Device Driver for HD44780 (LCD-II) Dot Matix Liquid Crystal
  * Display Controller/Driver. Supports simple text scroll, cursor, and
  * handling of special characters such as carriage-return, form-feed,
- * back-space, horizontal tab and new-line.
+ * back-space, horizontal tab and new-line. Optional line scroll mode
+ * with a line buffer, see scroll_mode(). The controller has no
+ * inverse characters; the text mode (alert and escape sequence SGR 7)
+ * is tracked but not rendered.
  *
  * @section References
  * 1. Product Specification, Hitachi, HD4478U, ADE-207-272(Z),
@@ -94,6 +97,104 @@ public:
      * @param[in] flag.
      */
     virtual void set_backlight(uint8_t flag) = 0;
+
+    /**
+     * @override{HD44780::Adapter}
+     * Returns true(1) if all written data has been transferred to the
+     * display otherwise false(0). Adapters with background transfer
+     * should override. Default is true(1).
+     * @return bool.
+     */
+    virtual bool is_idle()
+    {
+      return (true);
+    }
+
+    /**
+     * @override{HD44780::Adapter}
+     * Hold further transfers for given execution time. Adapters with
+     * queued transfer may record the hold in the queue instead of
+     * delaying the caller. Returns true(1) if the hold is recorded
+     * otherwise false(0); the driver delays. Default is false(0).
+     * @param[in] us execution time in micro-seconds.
+     * @return bool.
+     */
+    virtual bool hold(uint16_t us)
+    {
+      (void) us;
+      return (false);
+    }
+
+    /**
+     * @override{HD44780::Adapter}
+     * Start batch; adapters with a bus transaction overhead may
+     * collect port data until end_batch() and transfer it in as few
+     * transactions as possible. Default is no batch.
+     */
+    virtual void begin_batch() {}
+
+    /**
+     * @override{HD44780::Adapter}
+     * End batch and transfer collected port data.
+     */
+    virtual void end_batch() {}
+
+#if defined(LCD_STATISTICS)
+    /**
+     * Return statistics for byte and buffer writes; bytes written to
+     * the display and adapter latency.
+     * @return statistics.
+     */
+    LCD::Statistics& statistics()
+    {
+      return (m_statistics);
+    }
+
+  protected:
+    LCD::Statistics m_statistics; //!< Write statistics.
+#endif
+  };
+
+  /**
+   * Execution timer for adapters that write without reading the
+   * busy flag. The adapter starts the timer when a byte is written
+   * and waits only for the remaining execution time before the next.
+   */
+  class Exec_Timer {
+  public:
+    /**
+     * Construct execution timer.
+     */
+    Exec_Timer() : m_start(0) {}
+
+  protected:
+    /**
+     * Resolution of micros() (us); 4 us at 16 MHz and 8 us at 8 MHz.
+     * Added as margin to the execution time.
+     */
+    static const uint16_t MICROS_TICK = 8;
+
+    /**
+     * Start execution time of the latest byte.
+     */
+    void exec_start()
+    {
+      m_start = micros();
+    }
+
+    /**
+     * Wait for the remaining given execution time of the latest
+     * byte. The time spent since the byte was written is not waited
+     * for again.
+     * @param[in] us execution time (us).
+     */
+    void exec_wait(uint16_t us)
+    {
+      us += MICROS_TICK;
+      while ((uint16_t) (micros() - m_start) < us);
+    }
+
+    uint16_t m_start;		//!< Latest byte written (us).
   };
 
   /** Max size of custom character font bitmap. */
@@ -111,8 +212,11 @@ public:
    * @param[in] io port adapter.
    * @param[in] width of display, characters per line (Default 16).
    * @param[in] height of display, number of lines (Default 2).
+   * @param[in] split column where a single line display continues at
+   * the second line address, e.g. 8 for 16x1 (Default 0, none).
    */
-  HD44780(Adapter& io, uint8_t width = 16, uint8_t height = 2) :
+  HD44780(Adapter& io, uint8_t width = 16, uint8_t height = 2,
+	  uint8_t split = 0) :
     LCD::Device(),
     WIDTH(width),
     HEIGHT(height),
@@ -120,7 +224,15 @@ public:
     m_mode(ENTRY_MODE_SET | INCREMENT),
     m_cntl(CONTROL_SET),
     m_func(FUNCTION_SET | DATA_LENGTH_4BITS | NR_LINES_2 | FONT_5X8DOTS),
-    m_offset(NULL)
+    m_offset(NULL),
+    m_split(split != 0 ? split : width),
+    m_lines(NULL),
+    m_state(READY),
+    m_batch(0),
+    m_deadline(0),
+    m_queue(NULL),
+    m_queue_max(0),
+    m_queue_len(0)
   {}
 
   /**
@@ -130,45 +242,218 @@ public:
    * @return bool.
    */
   virtual bool begin()
+  {
+    begin_async();
+    while (!poll());
+    return (true);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Start display without blocking. The initialization sequence is
+   * run by poll(), with deadlines instead of delays. Text output and
+   * cursor positioning before the display is ready are queued if a
+   * queue buffer is given, see queue(), otherwise ignored. Returns
+   * true(1).
+   * @return bool.
+   */
+  virtual bool begin_async()
+  {
+    set_offset();
+    if (m_io.setup()) m_func |= DATA_LENGTH_8BITS;
+    m_queue_len = 0;
+    m_cntl |= DISPLAY_ON;
+    m_state = POWER_ON;
+    wait(POWER_ON_TIME * 1000UL);
+    return (true);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Run initialization steps that are due. Queued output is written
+   * when the initialization is completed. Returns true(1) if the
+   * display is ready otherwise false(0).
+   * @return bool.
+   */
+  virtual bool poll()
   {
     // Initiate display; See fig. 24, 4-bit interface, pp. 46.
     // http://web.alfredstate.edu/weimandn/lcd/lcd_initialization/-
     // LCD%204-bit%20Initialization%20v06.pdf
-    static const uint8_t offset0[] PROGMEM = { 0x00, 0x40, 0x14, 0x54 };
-    static const uint8_t offset1[] PROGMEM = { 0x00, 0x40, 0x10, 0x50 };
-    m_offset = ((HEIGHT == 4) && (WIDTH == 16) ? offset1 : offset0);
     const uint8_t FS0 = (FUNCTION_SET | DATA_LENGTH_8BITS);
     const uint8_t FS1 = (FUNCTION_SET | DATA_LENGTH_4BITS);
-    bool mode = m_io.setup();
-    delay(POWER_ON_TIME);
-    // 4-bit initialization mode
-    if (!mode) {
+    while (m_state != READY) {
+      if ((int32_t) (micros() - m_deadline) < 0) return (false);
+      switch (m_state) {
+      case POWER_ON:
+	// 8-bit initialization mode
+	if (m_func & DATA_LENGTH_8BITS) {
+	  io_write8b(m_func);
+	  m_state = SETUP;
+	}
+	// 4-bit initialization mode
+	else {
+	  m_io.write4b(FS0 >> 4);
+	  wait(INIT0_TIME);
+	  m_state = INIT0;
+	}
+	break;
+      case INIT0:
+	m_io.write4b(FS0 >> 4);
+	wait(INIT1_TIME);
+	m_state = INIT1;
+	break;
+      case INIT1:
+	m_io.write4b(FS0 >> 4);
+	wait(INIT1_TIME);
+	m_state = INIT2;
+	break;
+      case INIT2:
+	m_io.write4b(FS1 >> 4);
+	wait(INIT1_TIME);
+	m_state = SETUP;
+	break;
+      case SETUP:
+	// Initialization with the function and control setting; the
+	// control setting includes changes made before ready
+	io_write8b(m_func);
+	io_write8b(m_cntl);
+	text_normal_mode();
+	backlight_on();
+	io_write8b(CLEAR_DISPLAY);
+	wait(LONG_EXEC_TIME);
+	m_state = CLEAR;
+	break;
+      case CLEAR:
+	// Initialization completed. Clear sets increment; restore
+	// entry mode if changed. Write queued output
+	m_state = READY;
+	if (m_mode != (ENTRY_MODE_SET | INCREMENT)) io_write8b(m_mode);
+	m_x = 0;
+	m_y = 0;
+	drain();
+	break;
+      default:
+	m_state = READY;
+      }
+    }
+    return (true);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Returns true(1) if the display is ready otherwise false(0).
+   * @return bool.
+   */
+  virtual bool ready()
+  {
+    return (m_state == READY);
+  }
+
+  /**
+   * Returns true(1) if all output has been transferred to the display
+   * otherwise false(0). Output may be pending with adapters that
+   * transfer in the background.
+   * @return bool.
+   */
+  bool idle()
+  {
+    return (m_io.is_idle());
+  }
+
+#if defined(LCD_STATISTICS)
+  /**
+   * @override{LCD::Device}
+   * Print operation statistics and adapter write statistics.
+   * @param[in] out output stream.
+   */
+  virtual void dump(Print& out)
+  {
+    LCD::Device::dump(out);
+    m_io.statistics().dump(out, F("adapter"));
+  }
+#endif
+
+  /**
+   * @override{LCD::Device}
+   * Start batch of output. The adapter may collect commands and data
+   * until the outermost end_batch(), e.g. in a single TWI transfer.
+   */
+  virtual void begin_batch()
+  {
+    if (m_batch++ == 0) m_io.begin_batch();
+  }
+
+  /**
+   * @override{LCD::Device}
+   * End batch of output. The collected output is transferred by the
+   * outermost end_batch().
+   */
+  virtual void end_batch()
+  {
+    if (m_batch != 0 && --m_batch == 0) m_io.end_batch();
+  }
+
+  /**
+   * Resume display after a soft reset or wake-up from sleep, when the
+   * controller has been powered and has kept the display data,
+   * custom characters and settings. The interface is synchronized
+   * with a short function set sequence and the function, control and
+   * entry mode settings are written. The display is not cleared. The
+   * first function set is followed by a long execution time in case
+   * it completes an interrupted command. The cursor is moved to
+   * home(0, 0). Returns true(1).
+   * @return bool.
+   */
+  bool resume()
+  {
+    const uint8_t FS0 = (FUNCTION_SET | DATA_LENGTH_8BITS);
+    const uint8_t FS1 = (FUNCTION_SET | DATA_LENGTH_4BITS);
+    set_offset();
+    m_queue_len = 0;
+    m_state = READY;
+    // Synchronize 8-bit or 4-bit interface
+    if (m_io.setup()) {
+      m_func |= DATA_LENGTH_8BITS;
+    }
+    else {
       m_io.write4b(FS0 >> 4);
-      delayMicroseconds(INIT0_TIME);
+      delay_after(LONG_EXEC_TIME);
       m_io.write4b(FS0 >> 4);
-      delayMicroseconds(INIT1_TIME);
+      delay_after(INIT1_TIME);
       m_io.write4b(FS0 >> 4);
-      delayMicroseconds(INIT1_TIME);
+      delay_after(INIT1_TIME);
       m_io.write4b(FS1 >> 4);
-      delayMicroseconds(INIT1_TIME);
-    }
-    // 8-bit initialization mode
-    else {
-      m_io.write8b(m_func |= DATA_LENGTH_8BITS);
+      delay_after(INIT1_TIME);
     }
 
-    // Initialization with the function, control and mode setting
-    m_io.write8b(m_func);
-    m_io.write8b(m_cntl);
-
-    // Initialization completed. Turn on the display and backlight
-    text_normal_mode();
-    display_on();
+    // Restore function, control and entry mode setting
+    io_write8b(m_func);
+    io_write8b(m_cntl |= DISPLAY_ON);
+    io_write8b(ENTRY_MODE_SET | (m_mode & (INCREMENT | DISPLAY_SHIFT)));
     backlight_on();
-    display_clear();
+    cursor_set(0, 0);
     return (true);
   }
 
+  /**
+   * Set queue buffer for output before the display is ready. Text,
+   * cursor positioning, display shift and custom character and
+   * display data memory writes are queued; two bytes per cursor
+   * position or shift and three bytes plus data per memory write.
+   * Output that does not fit is ignored. Control and entry mode
+   * settings are not queued; they are written by the
+   * initialization.
+   * @param[in] buf queue buffer or NULL.
+   * @param[in] size of queue buffer.
+   */
+  void queue(uint8_t* buf, uint8_t size)
+  {
+    m_queue = buf;
+    m_queue_max = (buf == NULL ? 0 : size);
+    m_queue_len = 0;
+  }
+
   /**
    * @override{LCD::Device}
    * Turn display backlight on.
@@ -193,7 +478,7 @@ public:
    */
   virtual void display_on()
   {
-    m_io.write8b(m_cntl |= DISPLAY_ON);
+    command(m_cntl |= DISPLAY_ON);
   }
 
   /**
@@ -202,7 +487,7 @@ public:
    */
   virtual void display_off()
   {
-    m_io.write8b(m_cntl &= ~DISPLAY_ON);
+    command(m_cntl &= ~DISPLAY_ON);
   }
 
   /**
@@ -211,11 +496,18 @@ public:
    */
   virtual void display_clear()
   {
-    m_io.write8b(CLEAR_DISPLAY);
+    LCD_DEVICE_PROBE(STAT_DISPLAY_CLEAR, 0);
+    invalidate();
+    if (m_state != READY) {
+      m_queue_len = 0;
+      return;
+    }
+    if (m_lines != NULL) memset(m_lines, ' ', WIDTH * HEIGHT);
+    io_write8b(CLEAR_DISPLAY);
     m_x = 0;
     m_y = 0;
     m_mode |= INCREMENT;
-    delayMicroseconds(LONG_EXEC_TIME);
+    delay_after(LONG_EXEC_TIME);
   }
 
   /**
@@ -224,7 +516,7 @@ public:
    */
   virtual void cursor_blink_on()
   {
-    m_io.write8b(m_cntl |= BLINK_ON);
+    command(m_cntl |= BLINK_ON);
   }
 
   /**
@@ -233,7 +525,38 @@ public:
    */
   virtual void cursor_blink_off()
   {
-    m_io.write8b(m_cntl &= ~BLINK_ON);
+    command(m_cntl &= ~BLINK_ON);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Get display width (characters per line).
+   * @return width.
+   */
+  virtual uint8_t width() const
+  {
+    return (WIDTH);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Get display height (lines).
+   * @return height.
+   */
+  virtual uint8_t height() const
+  {
+    return (HEIGHT);
+  }
+
+  /**
+   * Get split column; the column where a single line display
+   * continues at the second line address, or WIDTH for none.
+   * @return column.
+   */
+  uint8_t split() const
+    __attribute__((always_inline))
+  {
+    return (m_split);
   }
 
   /**
@@ -244,10 +567,15 @@ public:
    */
   virtual void cursor_set(uint8_t x, uint8_t y)
   {
+    LCD_DEVICE_PROBE(STAT_CURSOR_SET, 0);
     if (x >= WIDTH) x = 0;
     if (y >= HEIGHT) y = 0;
-    uint8_t offset = (uint8_t) pgm_read_byte(&m_offset[y]);
-    m_io.write8b(SET_DDRAM_ADDR | ((x + offset) & SET_DDRAM_MASK));
+    if (m_state != READY) {
+      enqueue(QUEUE_CURSOR);
+      enqueue((y << 6) | x);
+      return;
+    }
+    io_write8b(SET_DDRAM_ADDR | (ddram_address(x, y) & SET_DDRAM_MASK));
     m_x = x;
     m_y = y;
   }
@@ -258,10 +586,28 @@ public:
    */
   virtual void cursor_home()
   {
-    m_io.write8b(RETURN_HOME);
+    if (m_state != READY) {
+      cursor_set(0, 0);
+      return;
+    }
+    io_write8b(RETURN_HOME);
     m_x = 0;
     m_y = 0;
-    delayMicroseconds(LONG_EXEC_TIME);
+    delay_after(LONG_EXEC_TIME);
+  }
+
+  /**
+   * Set scroll mode with given line buffer of WIDTH * HEIGHT bytes.
+   * The line buffer holds the display text. New-line on the last line
+   * will scroll the text up one line instead of moving to the first
+   * line. The display is cleared. Scroll mode is turned off with a
+   * NULL buffer.
+   * @param[in] buf line buffer or NULL.
+   */
+  void scroll_mode(uint8_t* buf)
+  {
+    m_lines = buf;
+    display_clear();
   }
 
   /**
@@ -270,7 +616,7 @@ public:
   void display_scroll_left()
     __attribute__((always_inline))
   {
-    m_io.write8b(SHIFT_SET | DISPLAY_MOVE | MOVE_LEFT);
+    command(SHIFT_SET | DISPLAY_MOVE | MOVE_LEFT);
   }
 
   /**
@@ -279,7 +625,7 @@ public:
   void display_scroll_right()
     __attribute__((always_inline))
   {
-    m_io.write8b(SHIFT_SET | DISPLAY_MOVE | MOVE_RIGHT);
+    command(SHIFT_SET | DISPLAY_MOVE | MOVE_RIGHT);
   }
 
   /**
@@ -288,7 +634,7 @@ public:
   void cursor_underline_on()
     __attribute__((always_inline))
   {
-    m_io.write8b(m_cntl |= CURSOR_ON);
+    command(m_cntl |= CURSOR_ON);
   }
 
   /**
@@ -297,7 +643,7 @@ public:
   void cursor_underline_off()
     __attribute__((always_inline))
   {
-    m_io.write8b(m_cntl &= ~CURSOR_ON);
+    command(m_cntl &= ~CURSOR_ON);
   }
 
 
@@ -307,7 +653,7 @@ public:
   void text_flow_right_to_left()
     __attribute__((always_inline))
   {
-    m_io.write8b(m_cntl &= ~INCREMENT);
+    command(m_mode &= ~INCREMENT);
   }
 
   /**
@@ -316,7 +662,7 @@ public:
   void text_scroll_left_adjust()
     __attribute__((always_inline))
   {
-    m_io.write8b(m_cntl |= DISPLAY_SHIFT);
+    command(m_mode |= DISPLAY_SHIFT);
   }
 
   /**
@@ -325,36 +671,117 @@ public:
   void text_scroll_right_adjust()
     __attribute__((always_inline))
   {
-    m_io.write8b(m_cntl &= ~DISPLAY_SHIFT);
+    command(m_mode &= ~DISPLAY_SHIFT);
   }
 
   /**
-   * Set custom character bitmap for given identity (0..7).
+   * Set custom character bitmap for given identity (0..7). Queued
+   * when the display is not ready, see queue().
    * @param[in] id character.
    * @param[in] bitmap pointer to bitmap.
    */
   void set_custom_char(uint8_t id, const uint8_t* bitmap)
   {
-    m_io.write8b(SET_CGRAM_ADDR | ((id << 3) & SET_CGRAM_MASK));
+    if (m_state != READY) {
+      enqueue(QUEUE_CGRAM, id << 3, bitmap, BITMAP_MAX);
+      return;
+    }
+    begin_batch();
+    io_write8b(SET_CGRAM_ADDR | ((id << 3) & SET_CGRAM_MASK));
     m_io.set_mode(true);
     for (uint8_t i = 0; i < BITMAP_MAX; i++)
-      m_io.write8b(*bitmap++);
+      io_write8b(*bitmap++);
     m_io.set_mode(false);
+    end_batch();
   }
 
   /**
    * Set custom character bitmap to given identity (0..7).
-   * The bitmap should be stored in program memory.
+   * The bitmap should be stored in program memory. Queued when the
+   * display is not ready, see queue().
    * @param[in] id character.
    * @param[in] bitmap pointer to program memory bitmap.
    */
   void set_custom_char_P(uint8_t id, const uint8_t* bitmap)
   {
-    m_io.write8b(SET_CGRAM_ADDR | ((id << 3) & SET_CGRAM_MASK));
+    if (m_state != READY) {
+      enqueue(QUEUE_CGRAM, id << 3, bitmap, BITMAP_MAX, true);
+      return;
+    }
+    begin_batch();
+    io_write8b(SET_CGRAM_ADDR | ((id << 3) & SET_CGRAM_MASK));
     m_io.set_mode(true);
     for (uint8_t i = 0; i < BITMAP_MAX; i++, bitmap++)
-      m_io.write8b(pgm_read_byte(bitmap));
+      io_write8b(pgm_read_byte(bitmap));
+    m_io.set_mode(false);
+    end_batch();
+  }
+
+  /**
+   * Write given custom character bitmap rows for given identity
+   * (0..7) starting with given row (0..7). The rows may continue
+   * into the following identities. Only the given rows are written;
+   * characters on the display using the identity are updated
+   * directly. The display data address is restored to the cursor
+   * position. Queued when the display is not ready, see queue().
+   * @param[in] id character.
+   * @param[in] row first bitmap row.
+   * @param[in] buf pointer to bitmap rows.
+   * @param[in] size number of rows.
+   */
+  void cgram_write(uint8_t id, uint8_t row, const void* buf, size_t size)
+  {
+    if (m_state != READY) {
+      enqueue(QUEUE_CGRAM, (id << 3) + row, buf, size);
+      return;
+    }
+    begin_batch();
+    io_write8b(SET_CGRAM_ADDR | (((id << 3) + row) & SET_CGRAM_MASK));
+    m_io.set_mode(true);
+    io_write8n(buf, size);
     m_io.set_mode(false);
+    cursor_restore();
+    end_batch();
+  }
+
+  /**
+   * Write character buffer directly to display data memory (DDRAM)
+   * at given column and line. The column is not limited to the
+   * display width; two line displays have 40 columns of DDRAM per
+   * line which may be brought into view with display_scroll_left()
+   * and display_scroll_right(). Special characters are not
+   * handled. The cursor position is not updated; use
+   * cursor_restore() or cursor_set() before further text output.
+   * Queued when the display is not ready, see queue().
+   * @param[in] x column in DDRAM line.
+   * @param[in] y line.
+   * @param[in] buf pointer to buffer.
+   * @param[in] size number of characters in buffer.
+   */
+  void ddram_write(uint8_t x, uint8_t y, const void* buf, size_t size)
+  {
+    if (y >= HEIGHT) y = 0;
+    if (m_state != READY) {
+      enqueue(QUEUE_DDRAM, (y << 6) | (x & 0x3f), buf, size);
+      return;
+    }
+    uint8_t offset = (uint8_t) pgm_read_byte(&m_offset[y]);
+    begin_batch();
+    io_write8b(SET_DDRAM_ADDR | ((x + offset) & SET_DDRAM_MASK));
+    m_io.set_mode(true);
+    io_write8n(buf, size);
+    m_io.set_mode(false);
+    end_batch();
+  }
+
+  /**
+   * Restore the display data address to the cursor position after
+   * direct memory writes, see ddram_write().
+   */
+  void cursor_restore()
+  {
+    if (m_state != READY) return;
+    io_write8b(SET_DDRAM_ADDR | (ddram_address(m_x, m_y) & SET_DDRAM_MASK));
   }
 
   /**
@@ -367,11 +794,19 @@ public:
    */
   virtual size_t write(uint8_t c)
   {
+    LCD_DEVICE_PROBE(STAT_WRITE, 1);
+    // Queue output until ready; queue markers are not characters
+    if (m_state != READY)
+      return (c < QUEUE_COMMAND || c > QUEUE_CURSOR ? enqueue(c) : 0);
+
+    // Check for escape sequence
+    if (escape(c)) return (1);
+
     // Check for special characters
     if (c < ' ') {
       switch (c) {
-      case '\a': // Alert: invert text mode
-	m_mode = ~m_mode;
+      case '\a': // Alert: invert text mode (not rendered)
+	LCD::Device::m_mode = ~LCD::Device::m_mode;
 	return (1);
       case '\b': // Back-space: move cursor back one step (if possible)
 	cursor_set(m_x - 1, m_y);
@@ -381,14 +816,18 @@ public:
       case '\f': // Form-feed: clear the display
 	display_clear();
 	return (1);
-      case '\n': // New-line: clear line
-	{
+      case '\n': // New-line: clear line or scroll
+	begin_batch();
+	if ((m_lines != NULL) && (m_y == HEIGHT - 1)) {
+	  scroll();
+	}
+	else {
 	  cursor_set(0, m_y + 1);
-	  m_io.set_mode(true);
-	  for (uint8_t i = 0; i < WIDTH; i++) write(' ');
-	  m_io.set_mode(false);
+	  blank_line();
 	  cursor_set(m_x, m_y);
+	  if (m_lines != NULL) memset(m_lines + WIDTH * m_y, ' ', WIDTH);
 	}
+	end_batch();
 	return (1);
       case '\r': // Carriage-return: move to start of line
 	cursor_set(0, m_y);
@@ -407,14 +846,321 @@ public:
 
     // Write character
     if (m_x == WIDTH) write('\n');
+    else if (m_x == m_split) cursor_set(m_x, m_y);
+    if (m_lines != NULL) m_lines[WIDTH * m_y + m_x] = c;
     m_x += 1;
     m_io.set_mode(true);
-    m_io.write8b(c);
+    io_write8b(c);
     m_io.set_mode(false);
     return (c & 0xff);
   }
 
+  /**
+   * @override{Arduino::Print}
+   * Write character buffer to display. Runs of characters on the
+   * current line are written with a single adapter transfer. Special
+   * characters and line wrap are handled by write(uint8_t). The
+   * buffer is written in one output batch.
+   * @param[in] buf pointer to buffer.
+   * @param[in] size number of characters in buffer.
+   * @return number of characters written.
+   */
+  virtual size_t write(const uint8_t* buf, size_t size)
+  {
+    LCD_DEVICE_PROBE(STAT_WRITE, size);
+    size_t res = size;
+    begin_batch();
+    while (size != 0) {
+      // Check for special characters, escape sequence, line wrap and queue
+      if (*buf < ' ' || m_esc > ESC_IDLE || m_x >= WIDTH
+	  || m_x == m_split || m_state != READY) {
+	write(*buf++);
+	size -= 1;
+	continue;
+      }
+
+      // Write characters up to end of line or next special character
+      uint8_t n = 0;
+      uint8_t max = (m_x < m_split ? m_split : WIDTH) - m_x;
+      while (n < max && n < size && buf[n] >= ' ') n++;
+      m_io.set_mode(true);
+      io_write8n(buf, n);
+      m_io.set_mode(false);
+      if (m_lines != NULL) memcpy(m_lines + WIDTH * m_y + m_x, buf, n);
+      m_x += n;
+      buf += n;
+      size -= n;
+    }
+    end_batch();
+    return (res);
+  }
+
 protected:
+  /** Initialization state. */
+  enum {
+    READY,			//!< Initialized.
+    POWER_ON,			//!< Wait for power on.
+    INIT0,			//!< Function set, 8-bit, first.
+    INIT1,			//!< - second.
+    INIT2,			//!< - third, then 4-bit.
+    SETUP,			//!< Function and control setting.
+    CLEAR			//!< Wait for display clear.
+  } __attribute__((packed));
+
+  /** Queue marker for cursor position; followed by (y << 6 | x). */
+  static const uint8_t QUEUE_CURSOR = 0x1f;
+
+  /**
+   * Queue marker for custom character memory write; followed by the
+   * address (id << 3 | row), number of bytes and data.
+   */
+  static const uint8_t QUEUE_CGRAM = 0x1e;
+
+  /**
+   * Queue marker for display data memory write; followed by the
+   * position (y << 6 | x), number of bytes and data.
+   */
+  static const uint8_t QUEUE_DDRAM = 0x1d;
+
+  /** Queue marker for command; followed by the command. */
+  static const uint8_t QUEUE_COMMAND = 0x1c;
+
+  /**
+   * Set row offset table for display geometry.
+   */
+  void set_offset()
+  {
+    static const uint8_t offset0[] PROGMEM = { 0x00, 0x40, 0x14, 0x54 };
+    static const uint8_t offset1[] PROGMEM = { 0x00, 0x40, 0x10, 0x50 };
+    m_offset = ((HEIGHT == 4) && (WIDTH == 16) ? offset1 : offset0);
+  }
+
+  /**
+   * Return display data address for given position. The column may
+   * be WIDTH (after the last character on the line); the address is
+   * then the controller address counter after the last character.
+   * @param[in] x.
+   * @param[in] y.
+   * @return address.
+   */
+  uint8_t ddram_address(uint8_t x, uint8_t y) const
+  {
+    if (y >= HEIGHT) y = HEIGHT - 1;
+    if (m_split < WIDTH && x >= m_split) {
+      x -= m_split;
+      y += 1;
+    }
+    return (x + (uint8_t) pgm_read_byte(&m_offset[y]));
+  }
+
+  /**
+   * Write byte to display with adapter; recorded in the adapter
+   * statistics if enabled.
+   * @param[in] data (8b) to write.
+   */
+  void io_write8b(uint8_t data)
+  {
+    LCD_PROBE(m_io.statistics(), 1);
+    m_io.write8b(data);
+  }
+
+  /**
+   * Write buffer to display with adapter; recorded in the adapter
+   * statistics if enabled.
+   * @param[in] buf pointer to buffer.
+   * @param[in] size number of bytes in buffer.
+   */
+  void io_write8n(const void* buf, size_t size)
+  {
+    LCD_PROBE(m_io.statistics(), size);
+    m_io.write8n(buf, size);
+  }
+
+  /**
+   * Write data collected in an open batch to the adapter, the batch
+   * continues.
+   */
+  void submit()
+  {
+    if (m_batch != 0) {
+      m_io.end_batch();
+      m_io.begin_batch();
+    }
+  }
+
+  /**
+   * Transfer data collected in an open batch, the batch continues,
+   * and wait for the adapter to complete.
+   */
+  void transfer()
+  {
+    submit();
+    while (!m_io.is_idle());
+  }
+
+  /**
+   * Set deadline for next initialization step. The deadline is
+   * counted from when the adapter has transferred the written data.
+   * The deadline is now if the adapter holds the queued transfer.
+   * @param[in] us micro-seconds from now.
+   */
+  void wait(uint32_t us)
+  {
+    submit();
+    if (us <= 0xffffUL && m_io.hold(us)) {
+      m_deadline = micros();
+      return;
+    }
+    transfer();
+    m_deadline = micros() + us;
+  }
+
+  /**
+   * Delay given execution time after the adapter has transferred the
+   * written data. No delay if the adapter holds the queued transfer.
+   * @param[in] us micro-seconds.
+   */
+  void delay_after(uint16_t us)
+  {
+    submit();
+    if (m_io.hold(us)) return;
+    transfer();
+    delayMicroseconds(us);
+  }
+
+  /**
+   * Write command if the display is ready. Before ready, control and
+   * entry mode settings are kept and written by the initialization
+   * sequence; other commands (display shift) are queued.
+   * @param[in] cmd command.
+   */
+  void command(uint8_t cmd)
+  {
+    if (m_state == READY) {
+      io_write8b(cmd);
+    }
+    else if (cmd >= SHIFT_SET) {
+      enqueue(QUEUE_COMMAND);
+      enqueue(cmd);
+    }
+  }
+
+  /**
+   * Append byte to queue. Returns one(1) if successful otherwise
+   * zero(0).
+   * @param[in] c byte to append.
+   * @return number of bytes queued.
+   */
+  size_t enqueue(uint8_t c)
+  {
+    if (m_queue_len == m_queue_max) return (0);
+    m_queue[m_queue_len++] = c;
+    return (1);
+  }
+
+  /**
+   * Append memory write record with given marker, address and data
+   * to queue. The record is ignored if it does not fit.
+   * @param[in] marker QUEUE_CGRAM or QUEUE_DDRAM.
+   * @param[in] addr address or position.
+   * @param[in] buf pointer to data.
+   * @param[in] size number of bytes.
+   * @param[in] progmem data in program memory (Default false).
+   */
+  void enqueue(uint8_t marker, uint8_t addr, const void* buf, size_t size,
+	       bool progmem = false)
+  {
+    if (size + 3 > (size_t) (m_queue_max - m_queue_len)) return;
+    const uint8_t* bp = (const uint8_t*) buf;
+    m_queue[m_queue_len++] = marker;
+    m_queue[m_queue_len++] = addr;
+    m_queue[m_queue_len++] = size;
+    while (size--)
+      m_queue[m_queue_len++] = (progmem ? pgm_read_byte(bp++) : *bp++);
+  }
+
+  /**
+   * Write queued output to display and empty queue.
+   */
+  void drain()
+  {
+    for (uint8_t i = 0; i < m_queue_len; i++) {
+      uint8_t c = m_queue[i];
+      if (c == QUEUE_CURSOR && i + 1 < m_queue_len) {
+	uint8_t pos = m_queue[++i];
+	cursor_set(pos & 0x3f, pos >> 6);
+      }
+      else if (c == QUEUE_COMMAND && i + 1 < m_queue_len) {
+	io_write8b(m_queue[++i]);
+      }
+      else if (c == QUEUE_CGRAM || c == QUEUE_DDRAM) {
+	uint8_t addr = m_queue[i + 1];
+	uint8_t n = m_queue[i + 2];
+	const uint8_t* bp = &m_queue[i + 3];
+	if (c == QUEUE_CGRAM) cgram_write(addr >> 3, addr & 0x07, bp, n);
+	else ddram_write(addr & 0x3f, addr >> 6, bp, n);
+	i += n + 2;
+      }
+      else {
+	write(c);
+      }
+    }
+    m_queue_len = 0;
+  }
+
+  /**
+   * Write given number of space characters at the current position
+   * with a single data mode transfer.
+   * @param[in] n number of spaces.
+   */
+  void blank(uint8_t n)
+  {
+    uint8_t buf[8];
+    memset(buf, ' ', sizeof(buf));
+    m_io.set_mode(true);
+    while (n != 0) {
+      uint8_t m = (n < sizeof(buf) ? n : sizeof(buf));
+      io_write8n(buf, m);
+      n -= m;
+    }
+    m_io.set_mode(false);
+  }
+
+  /**
+   * Write space characters to the current line starting at the first
+   * column. The line is written from the current address and for
+   * split displays also from the split column address.
+   */
+  void blank_line()
+  {
+    blank(m_split);
+    if (m_split < WIDTH) {
+      io_write8b(SET_DDRAM_ADDR | ddram_address(m_split, m_y));
+      blank(WIDTH - m_split);
+    }
+  }
+
+  /**
+   * Scroll lines in line buffer up one line and rewrite the display
+   * with one transfer per line. The cursor is moved to the start of
+   * the cleared last line.
+   */
+  void scroll()
+  {
+    uint8_t last = HEIGHT - 1;
+    memmove(m_lines, m_lines + WIDTH, WIDTH * last);
+    memset(m_lines + WIDTH * last, ' ', WIDTH);
+    for (uint8_t y = 0; y < last; y++) {
+      cursor_set(0, y);
+      m_io.set_mode(true);
+      io_write8n(m_lines + WIDTH * y, WIDTH);
+      m_io.set_mode(false);
+    }
+    cursor_set(0, last);
+    blank_line();
+    cursor_set(0, last);
+  }
+
   /**
    * Bus Timing Characteristics (in micro-seconds), fig. 25, pp. 50.
    */
@@ -489,9 +1235,205 @@ protected:
 
   /** Display pins and state (mirror of device registers). */
   Adapter& m_io;		//!< IO port adapter.
-  uint8_t m_mode;		//!< Entry mode.
+  uint8_t m_mode;		//!< Entry mode (hides text mode).
   uint8_t m_cntl;		//!< Control.
   uint8_t m_func;		//!< Function set.
   const uint8_t* m_offset;	//!< Row offset table.
+  uint8_t m_split;		//!< Split column or WIDTH.
+  uint8_t* m_lines;		//!< Line buffer for scroll mode or NULL.
+  uint8_t m_state;		//!< Initialization state.
+  uint8_t m_batch;		//!< Output batch nesting level.
+  uint32_t m_deadline;		//!< Initialization step deadline (us).
+  uint8_t* m_queue;		//!< Output queue before ready or NULL.
+  uint8_t m_queue_max;		//!< Size of output queue.
+  uint8_t m_queue_len;		//!< Number of bytes in output queue.
+};
+
+/**
+ * HD44780 with display geometry given at compile-time. The display
+ * data address of a position and the line wrap limits are constants
+ * and the cursor position is set without reading the row offset
+ * table. A split column is used for single line displays where the
+ * second half of the line is at the second line address (16x1). The
+ * runtime configured HD44780 may be used for displays with unknown
+ * geometry. Cursor positioning, text output, line wrap and new-line
+ * use the constant geometry. Other special characters, escape
+ * sequences, scroll mode and output before ready are handled by
+ * HD44780; the memory writes (ddram_write(), cgram_write()) use the
+ * row offset table.
+ * @param[in] W display width (characters per line).
+ * @param[in] H display height (lines).
+ * @param[in] SPLIT split column (Default W, none).
+ */
+template<uint8_t W, uint8_t H, uint8_t SPLIT = W>
+class HD44780_Geometry : public HD44780 {
+public:
+  /**
+   * Construct HD44780 LCD with compile-time geometry connected to
+   * given adapter.
+   * @param[in] io port adapter.
+   */
+  HD44780_Geometry(Adapter& io) :
+    HD44780(io, W, H, SPLIT)
+  {}
+
+  /**
+   * Return display data address for given position.
+   * @param[in] x.
+   * @param[in] y.
+   * @return address.
+   */
+  static uint8_t address(uint8_t x, uint8_t y)
+    __attribute__((always_inline))
+  {
+    if (SPLIT < W && x >= SPLIT) {
+      x -= SPLIT;
+      y += 1;
+    }
+    return (((y & 1) ? 0x40 : 0x00) + ((y & 2) ? W : 0) + x);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Get display width (characters per line).
+   * @return width.
+   */
+  virtual uint8_t width() const
+  {
+    return (W);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Get display height (lines).
+   * @return height.
+   */
+  virtual uint8_t height() const
+  {
+    return (H);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Set cursor position to given position.
+   * @param[in] x.
+   * @param[in] y.
+   */
+  virtual void cursor_set(uint8_t x, uint8_t y)
+  {
+    LCD_DEVICE_PROBE(STAT_CURSOR_SET, 0);
+    if (x >= W) x = 0;
+    if (y >= H) y = 0;
+    if (m_state != READY) {
+      HD44780::cursor_set(x, y);
+      return;
+    }
+    io_write8b(SET_DDRAM_ADDR | address(x, y));
+    m_x = x;
+    m_y = y;
+  }
+
+  /**
+   * @override{Arduino::Print}
+   * Write character to display. Printable characters, line wrap and
+   * new-line use the constant geometry. Returns number of
+   * characters(1) or zero(0) on error.
+   * @param[in] c character to write.
+   * @return number of characters written(1) or zero(0) for error.
+   */
+  virtual size_t write(uint8_t c)
+  {
+    LCD_DEVICE_PROBE(STAT_WRITE, 1);
+    // Special characters, escape sequence, scroll mode and queue
+    if (m_esc > ESC_IDLE || m_lines != NULL || m_state != READY
+	|| (c < ' ' && c != '\n'))
+      return (HD44780::write(c));
+
+    // New-line and line wrap; clear next line
+    if (c == '\n') {
+      new_line();
+      return (1);
+    }
+    if (m_x == W) new_line();
+    else if (SPLIT < W && m_x == SPLIT)
+      io_write8b(SET_DDRAM_ADDR | address(SPLIT, m_y));
+
+    // Write character
+    m_x += 1;
+    m_io.set_mode(true);
+    io_write8b(c);
+    m_io.set_mode(false);
+    return (1);
+  }
+
+  /**
+   * @override{Arduino::Print}
+   * Write character buffer to display. Runs of characters up to the
+   * end of the line, or the split column, are written with a single
+   * adapter transfer. The buffer is written in one output batch.
+   * @param[in] buf pointer to buffer.
+   * @param[in] size number of characters in buffer.
+   * @return number of characters written.
+   */
+  virtual size_t write(const uint8_t* buf, size_t size)
+  {
+    LCD_DEVICE_PROBE(STAT_WRITE, size);
+    if (m_lines != NULL) return (HD44780::write(buf, size));
+    size_t res = size;
+    begin_batch();
+    while (size != 0) {
+      // Check for special characters, escape sequence, line wrap and queue
+      if (*buf < ' ' || m_esc > ESC_IDLE || m_x >= W
+	  || m_x == SPLIT || m_state != READY) {
+	write(*buf++);
+	size -= 1;
+	continue;
+      }
+
+      // Write characters up to end of line or next special character
+      uint8_t n = 0;
+      uint8_t max = (m_x < SPLIT ? SPLIT : W) - m_x;
+      while (n < max && n < size && buf[n] >= ' ') n++;
+      m_io.set_mode(true);
+      io_write8n(buf, n);
+      m_io.set_mode(false);
+      m_x += n;
+      buf += n;
+      size -= n;
+    }
+    end_batch();
+    return (res);
+  }
+
+protected:
+  /**
+   * Move cursor to the start of the next line, wrap to the first
+   * line, and clear the line; both halves on split displays.
+   */
+  void new_line()
+  {
+    uint8_t y = (m_y + 1 < H ? m_y + 1 : 0);
+    begin_batch();
+    io_write8b(SET_DDRAM_ADDR | address(0, y));
+    blank(SPLIT);
+    if (SPLIT < W) {
+      io_write8b(SET_DDRAM_ADDR | address(SPLIT, y));
+      blank(W - SPLIT);
+    }
+    io_write8b(SET_DDRAM_ADDR | address(0, y));
+    m_x = 0;
+    m_y = y;
+    end_batch();
+  }
 };
+
+/** Common display geometries. */
+typedef HD44780_Geometry<8, 1> HD44780_0801;
+typedef HD44780_Geometry<16, 1, 8> HD44780_1601;
+typedef HD44780_Geometry<16, 2> HD44780_1602;
+typedef HD44780_Geometry<16, 4> HD44780_1604;
+typedef HD44780_Geometry<20, 2> HD44780_2002;
+typedef HD44780_Geometry<20, 4> HD44780_2004;
+typedef HD44780_Geometry<24, 2> HD44780_2402;
+typedef HD44780_Geometry<40, 2> HD44780_4002;
 #endif
@@ -240,11 +240,33 @@ public:
    */
   virtual void display_clear()
   {
+    LCD_DEVICE_PROBE(STAT_DISPLAY_CLEAR, 0);
+    invalidate();
     for (uint8_t reg = DIGIT0; reg <= DIGIT7; reg++)
       set(reg, 0x00);
     cursor_home();
   }
 
+  /**
+   * @override{LCD::Device}
+   * Get display width (characters per line).
+   * @return width.
+   */
+  virtual uint8_t width() const
+  {
+    return (WIDTH);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Get display height (lines).
+   * @return height.
+   */
+  virtual uint8_t height() const
+  {
+    return (HEIGHT);
+  }
+
   /**
    * @override{LCD::Device}
    * Set cursor to given position.
@@ -253,6 +275,7 @@ public:
    */
   virtual void cursor_set(uint8_t x, uint8_t y)
   {
+    LCD_DEVICE_PROBE(STAT_CURSOR_SET, 0);
     if (x >= WIDTH) x = 0;
     if (y >= HEIGHT) y = 0;
     m_x = x;
@@ -271,6 +294,10 @@ public:
    */
   virtual size_t write(uint8_t c)
   {
+    LCD_DEVICE_PROBE(STAT_WRITE, 1);
+    // Check for escape sequence
+    if (escape(c)) return (1);
+
     // Check for illegal characters
     if (c > 128) return (0);
 
@@ -33,6 +33,9 @@
  * @param[in] DC_PIN data/command select pin.
  * @param[in] SDIN_PIN screen data pin.
  * @param[in] SCLK_PIN screen clock pin.
+ * @param[in] PORT serial output port class (Default SRPO with
+ * SDIN_PIN and SCLK_PIN); a class with write(uint8_t), e.g. a meter
+ * wrapping SRPO.
  *
  * @section Circuit
  * PCD8544 is a low voltage device (3V3) and signals require level
@@ -58,7 +61,8 @@
 template<BOARD::pin_t SCE_PIN,
 	 BOARD::pin_t DC_PIN,
 	 BOARD::pin_t SDIN_PIN,
-	 BOARD::pin_t SCLK_PIN>
+	 BOARD::pin_t SCLK_PIN,
+	 typename PORT = SRPO<MSBFIRST, SDIN_PIN, SCLK_PIN> >
 class PCD8544 : public LCD::Device {
 public:
   /** Display size. */
@@ -272,11 +276,33 @@ public:
    */
   virtual void display_clear()
   {
+    LCD_DEVICE_PROBE(STAT_DISPLAY_CLEAR, 0);
+    invalidate();
     cursor_home();
     write_data(BACKGROUND, WIDTH * FONT_WIDTH * HEIGHT);
     cursor_home();
   }
 
+  /**
+   * @override{LCD::Device}
+   * Get display width (characters per line).
+   * @return width.
+   */
+  virtual uint8_t width() const
+  {
+    return (WIDTH);
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Get display height (lines).
+   * @return height.
+   */
+  virtual uint8_t height() const
+  {
+    return (HEIGHT);
+  }
+
   /**
    * @override{LCD::Device}
    * Set cursor to given position.
@@ -285,6 +311,7 @@ public:
    */
   virtual void cursor_set(uint8_t x, uint8_t y)
   {
+    LCD_DEVICE_PROBE(STAT_CURSOR_SET, 0);
     if (x >= WIDTH) x = 0;
     if (y >= HEIGHT) y = 0;
     write_command(SET_X_ADDR | ((x * FONT_WIDTH) & X_ADDR_MASK));
@@ -303,6 +330,10 @@ public:
    */
   virtual size_t write(uint8_t c)
   {
+    LCD_DEVICE_PROBE(STAT_WRITE, 1);
+    // Check for escape sequence
+    if (escape(c)) return (1);
+
     // Check for special characters
     if (c < ' ') {
       switch (c) {
@@ -319,6 +350,7 @@ public:
       case '\n': // Check for line-feed: clear new line
 	cursor_set(0, m_y + 1);
 	write_data(BACKGROUND, FONT_WIDTH * WIDTH);
+	// Fall through
       case '\r': // Carriage-return: move to start of line
 	cursor_set(0, m_y);
 	return (1);
@@ -348,6 +380,42 @@ public:
     return (1);
   }
 
+  /**
+   * @override{Arduino::Print}
+   * Write character buffer to display. Runs of characters on the
+   * current line are written within a single chip select. Special
+   * characters and line wrap are handled by write(uint8_t).
+   * @param[in] buf pointer to buffer.
+   * @param[in] size number of characters in buffer.
+   * @return number of characters written.
+   */
+  virtual size_t write(const uint8_t* buf, size_t size)
+  {
+    LCD_DEVICE_PROBE(STAT_WRITE, size);
+    size_t res = size;
+    while (size != 0) {
+      // Check for special characters, escape sequence and line wrap
+      if (*buf < ' ' || m_esc > ESC_IDLE || m_x >= WIDTH) {
+	write(*buf++);
+	size -= 1;
+	continue;
+      }
+
+      // Write characters up to end of line or next special character
+      m_sce.low();
+      do {
+	uint8_t width = FONT_WIDTH - 1;
+	const uint8_t* fp = m_font + ((*buf++ - ' ') * width);
+	do m_srpo.write(m_mode ^ pgm_read_byte(fp++)); while (--width);
+	m_srpo.write(m_mode);
+	m_x += 1;
+	size -= 1;
+      } while (size != 0 && m_x < WIDTH && *buf >= ' ');
+      m_sce.high();
+    }
+    return (res);
+  }
+
 protected:
   /**
    * Instruction set (table 1, pp. 14).
@@ -387,7 +455,7 @@ protected:
   GPIO<DC_PIN> m_dc;
 
   /** Screen data input and clock pins; Serial Ouput. */
-  SRPO<MSBFIRST, SDIN_PIN, SCLK_PIN> m_srpo;
+  PORT m_srpo;
 
   /** Font (5x7), program memory pointer. */
   const uint8_t* m_font;
@@ -19,6 +19,23 @@
 #ifndef LCD_H
 #define LCD_H
 
+#include "Statistics.h"
+
+/**
+ * Screen template position; text that follows is written at the
+ * given column and line. See LCD::Device::print_screen_P().
+ * @param[in] x column (decimal literal).
+ * @param[in] y line (decimal literal).
+ */
+#define LCD_SCREEN_AT(x, y) "\x1e" #x "," #y ";"
+
+/**
+ * Screen template field placeholder; the next field is positioned
+ * at the current column and line. The placeholder does not occupy a
+ * column. See LCD::Device::print_screen_P().
+ */
+#define LCD_SCREEN_FIELD "\x1f"
+
 namespace LCD {
 /**
  * Common interface for LCD; LCD::Device as the base class for device drivers.
@@ -33,7 +50,13 @@ public:
     m_x(0),
     m_y(0),
     m_tab(4),
-    m_mode(0)
+    m_mode(0),
+    m_esc(ESC_OFF),
+    m_nparam(0),
+    m_fields(NULL)
+#if defined(LCD_STATISTICS)
+    , m_depth(0)
+#endif
   {}
 
   /**
@@ -44,6 +67,39 @@ public:
    */
   virtual bool begin() = 0;
 
+  /**
+   * @override{LCD::Device}
+   * Start display without blocking. The start sequence is completed
+   * by calling poll() until the display is ready(). Default is a
+   * blocking begin(). Returns true if successful otherwise false.
+   * @return boolean.
+   */
+  virtual bool begin_async()
+  {
+    return (begin());
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Run pending start sequence steps that are due. Returns true if
+   * the display is ready otherwise false.
+   * @return boolean.
+   */
+  virtual bool poll()
+  {
+    return (ready());
+  }
+
+  /**
+   * @override{LCD::Device}
+   * Returns true if the display is ready for output otherwise false.
+   * @return boolean.
+   */
+  virtual bool ready()
+  {
+    return (true);
+  }
+
   /**
    * @override{LCD::Device}
    * Stop display and power down. Returns true if successful
@@ -102,7 +158,8 @@ public:
 
   /**
    * @override{LCD::Device}
-   * Clear display and move cursor to home.
+   * Clear display and move cursor to home. Implementations should
+   * invalidate the attached fields, see invalidate().
    */
   virtual void display_clear() = 0;
 
@@ -153,6 +210,74 @@ public:
    */
   virtual void cursor_update() {}
 
+  /**
+   * @override{LCD::Device}
+   * Start batch of output. Devices with a bus transaction overhead
+   * may collect the output until end_batch(). Batches may be
+   * nested. Default is no batch.
+   */
+  virtual void begin_batch() {}
+
+  /**
+   * @override{LCD::Device}
+   * End batch of output and transfer collected output.
+   */
+  virtual void end_batch() {}
+
+  /** Operations with statistics, see LCD_STATISTICS. */
+  enum {
+    STAT_CURSOR_SET,		//!< cursor_set().
+    STAT_WRITE,			//!< write(), character or buffer.
+    STAT_DISPLAY_CLEAR,		//!< display_clear().
+    STAT_FLUSH,			//!< flush().
+    STAT_MAX			//!< Number of operations.
+  } __attribute__((packed));
+
+#if defined(LCD_STATISTICS)
+  /**
+   * Return statistics for given operation.
+   * @param[in] op operation (STAT_CURSOR_SET..STAT_FLUSH).
+   * @return statistics.
+   */
+  Statistics& statistics(uint8_t op)
+  {
+    if (op >= STAT_MAX) op = STAT_FLUSH;
+    return (m_statistics[op]);
+  }
+
+  /**
+   * Print operation statistics, one line per operation.
+   * @param[in] out output stream.
+   */
+  virtual void dump(Print& out)
+  {
+    m_statistics[STAT_CURSOR_SET].dump(out, F("cursor_set"));
+    m_statistics[STAT_WRITE].dump(out, F("write"));
+    m_statistics[STAT_DISPLAY_CLEAR].dump(out, F("display_clear"));
+    m_statistics[STAT_FLUSH].dump(out, F("flush"));
+  }
+#endif
+
+  /**
+   * Get display width (characters per line). Default is zero(0) for
+   * unknown geometry; drivers should override.
+   * @return width.
+   */
+  virtual uint8_t width() const
+  {
+    return (0);
+  }
+
+  /**
+   * Get display height (lines). Default is zero(0) for unknown
+   * geometry; drivers should override.
+   * @return height.
+   */
+  virtual uint8_t height() const
+  {
+    return (0);
+  }
+
   /**
    * Get tab step.
    * @return tab step.
@@ -200,11 +325,613 @@ public:
     m_mode = 0xff;
   }
 
+  /**
+   * Turn escape sequence interpretation on. The write path will
+   * handle a subset of ANSI/VT100 control sequences; CSI row;col H
+   * (cursor position), CSI n A/B/C/D (cursor movement), CSI n J
+   * (erase screen; 0 to end, 1 to cursor, 2 entire screen), CSI n K
+   * (erase line; 0 to end, 1 to cursor, 2 entire line) and CSI n m
+   * (SGR, 7 for inverse and 0/27 for normal text mode).
+   */
+  void escape_sequence_on()
+    __attribute__((always_inline))
+  {
+    m_esc = ESC_IDLE;
+  }
+
+  /**
+   * Turn escape sequence interpretation off (default).
+   */
+  void escape_sequence_off()
+    __attribute__((always_inline))
+  {
+    m_esc = ESC_OFF;
+  }
+
+  /**
+   * Print given value as a fixed-point number with given number of
+   * decimals (scale). The number is right adjusted in a field of
+   * given width and padded with given character (space or zero).
+   * The characters are formatted in a buffer and written to the
+   * device with a single call.
+   * @param[in] value fixed-point value.
+   * @param[in] scale number of decimals (Default 0).
+   * @param[in] width minimum field width (Default 0).
+   * @param[in] pad character (Default space).
+   * @return number of characters written.
+   */
+  size_t print_fixed(int32_t value,
+		     uint8_t scale = 0,
+		     uint8_t width = 0,
+		     char pad = ' ')
+  {
+    bool negative = (value < 0);
+    uint32_t digits = (negative ? -(uint32_t) value : (uint32_t) value);
+    return (format(digits, negative, 10, scale, 0, width, pad));
+  }
+
+  /**
+   * Print given floating point value with given number of decimals
+   * using fixed-point formatting. Prints "nan" for not-a-number and
+   * falls back to Print::print() when the scaled value does not fit
+   * in 32-bit.
+   * @param[in] value floating point value.
+   * @param[in] decimals number of decimals (Default 2).
+   * @param[in] width minimum field width (Default 0).
+   * @param[in] pad character (Default space).
+   * @return number of characters written.
+   */
+  size_t print_float(double value,
+		     uint8_t decimals = 2,
+		     uint8_t width = 0,
+		     char pad = ' ')
+  {
+    if (isnan(value)) return (print(F("nan")));
+    double scaled = value;
+    for (uint8_t i = 0; i < decimals; i++) scaled *= 10;
+    scaled += (scaled < 0 ? -0.5 : 0.5);
+    if (scaled >= 2147483647.0 || scaled <= -2147483647.0)
+      return (print(value, decimals));
+    return (print_fixed((int32_t) scaled, decimals, width, pad));
+  }
+
+  /**
+   * Print given unsigned value in given base (BIN, OCT, DEC, HEX)
+   * with given minimum number of digits (zero filled). The digits
+   * may be grouped with a space separator, e.g. nibbles in binary.
+   * @param[in] value to print.
+   * @param[in] base number base (2..16).
+   * @param[in] digits minimum number of digits (Default 0).
+   * @param[in] group number of digits per group (Default 0, none).
+   * @return number of characters written.
+   */
+  size_t print_base(uint32_t value,
+		    uint8_t base,
+		    uint8_t digits = 0,
+		    uint8_t group = 0)
+  {
+    uint8_t width = digits;
+    if (group != 0 && digits != 0) width += (digits - 1) / group;
+    return (format(value, false, base, 0, group, width, '0'));
+  }
+
+  /**
+   * Display field with position, width, alignment and latest
+   * rendered text. Fields are attached to the device and updated
+   * with Device::update(). Use LCD::Field<WIDTH> to declare a field
+   * with text buffer.
+   */
+  class Field {
+  public:
+    /** Text alignment within field. */
+    enum {
+      LEFT = 0,			//!< Left adjusted.
+      RIGHT = 1,		//!< Right adjusted.
+      CENTER = 2		//!< Centered.
+    } __attribute__((packed));
+
+    /**
+     * Construct field at given position with given width, text
+     * buffer and alignment.
+     * @param[in] x field position.
+     * @param[in] y field position.
+     * @param[in] width number of characters (max FORMAT_MAX).
+     * @param[in] text buffer for latest rendered text (width).
+     * @param[in] align text alignment (LEFT, RIGHT or CENTER).
+     */
+    Field(uint8_t x, uint8_t y, uint8_t width, char* text, uint8_t align) :
+      m_next(NULL),
+      m_text(text),
+      m_x(x),
+      m_y(y),
+      m_width(width < FORMAT_MAX ? width : FORMAT_MAX),
+      m_align(align)
+    {
+      invalidate();
+    }
+
+    /**
+     * Move field to given position. The next update will write all
+     * characters.
+     * @param[in] x field position.
+     * @param[in] y field position.
+     */
+    void position(uint8_t x, uint8_t y)
+    {
+      m_x = x;
+      m_y = y;
+      invalidate();
+    }
+
+    /**
+     * Mark rendered text as unknown. The next update will write all
+     * characters.
+     */
+    void invalidate()
+    {
+      memset(m_text, 0, m_width);
+    }
+
+  protected:
+    friend class Device;
+    Field* m_next;		//!< Next field in device registry.
+    char* m_text;		//!< Latest rendered text.
+    uint8_t m_x;		//!< Field position x.
+    uint8_t m_y;		//!< Field position y.
+    uint8_t m_width;		//!< Field width.
+    uint8_t m_align;		//!< Text alignment.
+  };
+
+  /**
+   * Attach given field to the device field registry. The field is
+   * written in full on the next update.
+   * @param[in] field to attach.
+   */
+  void attach(Field& field)
+  {
+    field.m_next = m_fields;
+    field.invalidate();
+    m_fields = &field;
+  }
+
+  /**
+   * Detach given field from the device field registry.
+   * @param[in] field to detach.
+   */
+  void detach(Field& field)
+  {
+    Field** fp = &m_fields;
+    while (*fp != NULL && *fp != &field) fp = &(*fp)->m_next;
+    if (*fp != NULL) *fp = field.m_next;
+    field.m_next = NULL;
+  }
+
+  /**
+   * Mark the rendered text of all attached fields as unknown. Called
+   * by the device drivers on display_clear(). Should be called when
+   * the display has been overwritten.
+   */
+  void invalidate()
+  {
+    for (Field* fp = m_fields; fp != NULL; fp = fp->m_next)
+      fp->invalidate();
+  }
+
+  /**
+   * Update field with given text. Nothing is written if the text
+   * has not changed. Otherwise the characters from the first to the
+   * last difference are written after a single cursor_set(). The
+   * cursor is left after the written characters.
+   * @param[in] field to update.
+   * @param[in] text to display in field.
+   * @return number of characters written.
+   */
+  size_t update(Field& field, const char* text)
+  {
+    return (render(field, text, strlen(text)));
+  }
+
+  /**
+   * Update field with given fixed-point value with given number of
+   * decimals (scale). Nothing is written if the formatted value has
+   * not changed; see update(Field&, const char*).
+   * @param[in] field to update.
+   * @param[in] value fixed-point value.
+   * @param[in] scale number of decimals (Default 0).
+   * @return number of characters written.
+   */
+  size_t update(Field& field, int32_t value, uint8_t scale = 0)
+  {
+    char buf[FORMAT_MAX];
+    char* const end = buf + sizeof(buf);
+    bool negative = (value < 0);
+    uint32_t digits = (negative ? -(uint32_t) value : (uint32_t) value);
+    char* bp = format_number(buf, end, digits, negative, 10, scale, 0, 0, ' ');
+    return (render(field, bp, end - bp));
+  }
+
+  /**
+   * Print screen template in program memory. The template is a
+   * string of lines separated with new-line. LCD_SCREEN_AT(x, y)
+   * moves to the given position, and LCD_SCREEN_FIELD positions the
+   * next of the given fields. The fields are invalidated so that the
+   * next update writes all characters. The text is read from
+   * program memory into a buffer and written with one write() per
+   * line (up to FORMAT_MAX characters) in a single output batch.
+   * The display is not cleared.
+   * @param[in] screen template in program memory.
+   * @param[in] fields to position (Default NULL).
+   * @param[in] count number of fields (Default 0).
+   * @return number of characters written.
+   *
+   * @section Example
+   * @code
+   * static const char screen[] PROGMEM =
+   *   "Temp:       C\n"
+   *   "Hum:        %"
+   *   LCD_SCREEN_AT(6, 0) LCD_SCREEN_FIELD
+   *   LCD_SCREEN_AT(6, 1) LCD_SCREEN_FIELD;
+   * LCD::Device::Field* fields[] = { &temp, &hum };
+   * ...
+   * lcd.print_screen_P(screen, fields, 2);
+   * ...
+   * lcd.update(temp, value, 1);
+   * @endcode
+   */
+  size_t print_screen_P(const char* screen,
+			Field* const* fields = NULL,
+			uint8_t count = 0)
+  {
+    uint8_t buf[FORMAT_MAX];
+    size_t res = 0;
+    uint8_t n = 0;
+    uint8_t x = 0;
+    uint8_t y = 0;
+    uint8_t ix = 0;
+    char c;
+
+    begin_batch();
+    cursor_set(x, y);
+    do {
+      c = pgm_read_byte(screen++);
+      // Write buffered text on position change, full buffer or end
+      if (n != 0
+	  && (c == '\n' || c == SCREEN_AT || c == 0 || n == sizeof(buf))) {
+	res += write(buf, n);
+	x += n;
+	n = 0;
+      }
+      if (c == '\n') {
+	x = 0;
+	y += 1;
+	cursor_set(x, y);
+      }
+      else if (c == SCREEN_AT) {
+	x = 0;
+	while ((c = pgm_read_byte(screen++)) != ',') x = x * 10 + c - '0';
+	y = 0;
+	while ((c = pgm_read_byte(screen++)) != ';') y = y * 10 + c - '0';
+	cursor_set(x, y);
+      }
+      else if (c == SCREEN_FIELD) {
+	if (ix < count) fields[ix++]->position(x + n, y);
+      }
+      else if (c != 0) {
+	buf[n++] = c;
+      }
+    } while (c != 0);
+    end_batch();
+    return (res);
+  }
+
 protected:
+  /** Escape sequence parser state. */
+  enum {
+    ESC_OFF = 0,		//!< Escape sequences are not interpreted.
+    ESC_IDLE = 1,		//!< Wait for escape character.
+    ESC_START = 2,		//!< Escape character received.
+    ESC_CSI = 3			//!< Control Sequence Introducer received.
+  } __attribute__((packed));
+
+  /** Screen template position and field placeholder. */
+  enum {
+    SCREEN_AT = 0x1e,		//!< Position; "x,y;" follows.
+    SCREEN_FIELD = 0x1f		//!< Field placeholder.
+  } __attribute__((packed));
+
+  /** Max number of escape sequence parameters. */
+  static const uint8_t ESC_PARAM_MAX = 2;
+
+  /**
+   * Check for escape sequence character. Should be called first in
+   * the device driver write(uint8_t). Returns true if the character
+   * was consumed by the escape sequence parser otherwise false.
+   * @param[in] c character.
+   * @return bool.
+   */
+  bool escape(uint8_t c)
+    __attribute__((always_inline))
+  {
+    if (m_esc == ESC_OFF) return (false);
+    if (m_esc == ESC_IDLE && c != '\033') return (false);
+    return (escape_sequence(c));
+  }
+
+  /**
+   * Escape sequence parser. Collects parameters and executes the
+   * command on the final character. Cursor moves to the current
+   * position are skipped. Returns true if the character was consumed
+   * otherwise false.
+   * @param[in] c character.
+   * @return bool.
+   */
+  bool escape_sequence(uint8_t c)
+  {
+    // Start of escape sequence; wait for control sequence introducer
+    if (m_esc == ESC_IDLE) {
+      m_esc = ESC_START;
+      return (true);
+    }
+    if (m_esc == ESC_START) {
+      if (c != '[') {
+	m_esc = ESC_IDLE;
+	return (false);
+      }
+      memset(m_param, 0, sizeof(m_param));
+      m_nparam = 0;
+      m_esc = ESC_CSI;
+      return (true);
+    }
+
+    // Collect parameters; decimal numbers separated by semicolon
+    if (c >= '0' && c <= '9') {
+      if (m_nparam < ESC_PARAM_MAX) {
+	uint8_t& param = m_param[m_nparam];
+	param = (param < 25 ? param * 10 + (c - '0') : 255);
+      }
+      return (true);
+    }
+    if (c == ';') {
+      if (m_nparam < ESC_PARAM_MAX) m_nparam += 1;
+      return (true);
+    }
+    if (c == '?') return (true);
+    m_esc = ESC_IDLE;
+
+    // Execute command on final character
+    uint8_t n = (m_param[0] != 0 ? m_param[0] : 1);
+    uint8_t w = (width() != 0 ? width() : FORMAT_MAX);
+    uint8_t h = (height() != 0 ? height() : 255);
+    uint8_t x = (m_x < w ? m_x : w - 1);
+    uint8_t y = m_y;
+    switch (c) {
+    case 'H': // Cursor position (row;column), one-based
+    case 'f':
+      y = (m_param[0] != 0 ? m_param[0] - 1 : 0);
+      x = (m_param[1] != 0 ? m_param[1] - 1 : 0);
+      break;
+    case 'A': // Cursor up
+      y = (y > n ? y - n : 0);
+      break;
+    case 'B': // Cursor down
+      y = (y + n < h ? y + n : h - 1);
+      break;
+    case 'C': // Cursor forward
+      x = (x + n < w ? x + n : w - 1);
+      break;
+    case 'D': // Cursor back
+      x = (x > n ? x - n : 0);
+      break;
+    case 'J': // Erase display; 0 to end, 1 to cursor, 2 entire display
+      if (m_param[0] == 2) {
+	display_clear();
+      }
+      else if (m_param[0] == 0) {
+	erase(x, w, y);
+	for (uint8_t i = y + 1; i < height(); i++) erase(0, w, i);
+	invalidate();
+      }
+      else if (m_param[0] == 1) {
+	for (uint8_t i = 0; i < y; i++) erase(0, w, i);
+	erase(0, x + 1, y);
+	invalidate();
+      }
+      break;
+    case 'K': // Erase line; 0 to end, 1 to cursor, 2 entire line
+      if (m_param[0] == 0) erase(x, w, y);
+      else if (m_param[0] == 1) erase(0, x + 1, y);
+      else if (m_param[0] == 2) erase(0, w, y);
+      break;
+    case 'm': // Select graphic rendition; normal or inverse text
+      // Character displays (HD44780) only track the text mode
+      for (uint8_t i = 0; i <= m_nparam && i < ESC_PARAM_MAX; i++) {
+	if (m_param[i] == 7) text_inverted_mode();
+	else if (m_param[i] == 0 || m_param[i] == 27) text_normal_mode();
+      }
+      return (true);
+    default:
+      return (true);
+    }
+    if (x != m_x || y != m_y) cursor_set(x, y);
+    return (true);
+  }
+
+  /** Max number of characters in formatted number or field. */
+  static const uint8_t FORMAT_MAX = 40;
+
+  /**
+   * Erase given line from first to last column (exclusive) with
+   * blanks. The cursor is left after the erased characters.
+   * @param[in] first column.
+   * @param[in] last column (exclusive).
+   * @param[in] y line.
+   */
+  void erase(uint8_t first, uint8_t last, uint8_t y)
+  {
+    char buf[FORMAT_MAX];
+    if (last > first + sizeof(buf)) last = first + sizeof(buf);
+    memset(buf, ' ', sizeof(buf));
+    if (first != m_x || y != m_y) cursor_set(first, y);
+    write((const uint8_t*) buf, last - first);
+  }
+
+  /**
+   * Format number in given buffer, right to left from the end of
+   * the buffer, and write the characters to the device.
+   * @param[in] value absolute value.
+   * @param[in] negative sign flag.
+   * @param[in] base number base (2..16).
+   * @param[in] scale number of decimals.
+   * @param[in] group number of digits per group (zero for none).
+   * @param[in] width minimum field width.
+   * @param[in] pad character.
+   * @return number of characters written.
+   */
+  size_t format(uint32_t value, bool negative, uint8_t base,
+		uint8_t scale, uint8_t group, uint8_t width, char pad)
+  {
+    char buf[FORMAT_MAX];
+    char* const end = buf + sizeof(buf);
+    char* bp = format_number(buf, end, value, negative, base,
+			     scale, group, width, pad);
+    return (write((const uint8_t*) bp, end - bp));
+  }
+
+  /**
+   * Format number right to left in given buffer. Returns pointer to
+   * first character. The number ends at the end of the buffer.
+   * @param[in] buf buffer start.
+   * @param[in] end buffer end.
+   * @param[in] value absolute value.
+   * @param[in] negative sign flag.
+   * @param[in] base number base (2..16).
+   * @param[in] scale number of decimals.
+   * @param[in] group number of digits per group (zero for none).
+   * @param[in] width minimum field width.
+   * @param[in] pad character.
+   * @return pointer to first character.
+   */
+  static char* format_number(char* buf, char* end,
+			     uint32_t value, bool negative, uint8_t base,
+			     uint8_t scale, uint8_t group,
+			     uint8_t width, char pad)
+  {
+    char* bp = end;
+    uint8_t shift = 0;
+    uint8_t n = 0;
+
+    // Use shift and mask for power of two bases
+    if (base < 2 || base > 16) base = 10;
+    if ((base & (base - 1)) == 0)
+      for (uint8_t b = base; b > 1; b >>= 1) shift += 1;
+    if (width > end - buf) width = end - buf;
+
+    // Generate digits, decimal point and group separators
+    do {
+      if (scale != 0 && n == scale) *--bp = '.';
+      else if (group != 0 && n > scale && ((n - scale) % group) == 0)
+	*--bp = ' ';
+      uint8_t digit;
+      if (shift != 0) {
+	digit = value & (base - 1);
+	value >>= shift;
+      }
+      else {
+	uint32_t quotient = value / base;
+	digit = value - quotient * base;
+	value = quotient;
+      }
+      *--bp = (digit < 10 ? '0' + digit : 'A' - 10 + digit);
+      n += 1;
+    } while ((value != 0 || n <= scale) && bp > buf + 2);
+
+    // Zero fill; sign and separators are part of the field width
+    if (pad == '0') {
+      while (bp > buf + 2 && (end - bp) + negative < width) {
+	if (group != 0 && ((n - scale) % group) == 0) {
+	  if ((end - bp) + negative + 1 >= width) break;
+	  *--bp = ' ';
+	}
+	*--bp = '0';
+	n += 1;
+      }
+    }
+    if (negative) *--bp = '-';
+
+    // Space fill
+    if (pad == '0') pad = ' ';
+    while (bp > buf && (end - bp) < width) *--bp = pad;
+    return (bp);
+  }
+
+  /**
+   * Render given text in field with alignment and write the
+   * characters that differ from the latest rendered text.
+   * @param[in] field to update.
+   * @param[in] text to display in field.
+   * @param[in] len number of characters in text.
+   * @return number of characters written.
+   */
+  size_t render(Field& field, const char* text, size_t len)
+  {
+    char buf[FORMAT_MAX];
+    uint8_t width = field.m_width;
+    uint8_t pos = 0;
+
+    // Align text in field; truncate if longer than field
+    if (len > width) len = width;
+    if (field.m_align == Field::RIGHT) pos = width - len;
+    else if (field.m_align == Field::CENTER) pos = (width - len) / 2;
+    memset(buf, ' ', width);
+    memcpy(buf + pos, text, len);
+
+    // Locate the first and last difference; skip if unchanged
+    uint8_t first = 0;
+    while (first < width && buf[first] == field.m_text[first]) first++;
+    if (first == width) return (0);
+    uint8_t last = width - 1;
+    while (buf[last] == field.m_text[last]) last--;
+
+    // Write the changed characters with a single cursor move
+    uint8_t n = last - first + 1;
+    memcpy(field.m_text + first, buf + first, n);
+    cursor_set(field.m_x + first, field.m_y);
+    return (write((const uint8_t*) buf + first, n));
+  }
+
   uint8_t m_x;			//!< Cursor position x.
   uint8_t m_y;			//!< Cursor position y.
   uint8_t m_tab;		//!< Tab step.
   uint8_t m_mode;		//!< Text mode.
+  uint8_t m_esc;		//!< Escape sequence parser state.
+  uint8_t m_nparam;		//!< Escape sequence parameter index.
+  uint8_t m_param[ESC_PARAM_MAX]; //!< Escape sequence parameters.
+  Field* m_fields;		//!< Field registry.
+#if defined(LCD_STATISTICS)
+  Statistics m_statistics[STAT_MAX]; //!< Operation statistics.
+  uint8_t m_depth;		//!< Operation nesting depth.
+#endif
+};
+
+/**
+ * Display field with text buffer for given number of characters.
+ * @param[in] WIDTH number of characters in field.
+ */
+template<uint8_t WIDTH>
+class Field : public Device::Field {
+public:
+  /**
+   * Construct field at given position with given alignment.
+   * @param[in] x field position.
+   * @param[in] y field position.
+   * @param[in] align text alignment (Default RIGHT).
+   */
+  Field(uint8_t x, uint8_t y, uint8_t align = RIGHT) :
+    Device::Field(x, y, WIDTH, m_buf, align)
+  {}
+
+protected:
+  char m_buf[WIDTH];		//!< Latest rendered text.
 };
 };
 #endif
@@ -0,0 +1,203 @@
+/**
+ * @file Statistics.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef LCD_STATISTICS_H
+#define LCD_STATISTICS_H
+
+/**
+ * Record operation statistics in the given scope; call count, byte
+ * count and latency. Compiled out unless LCD_STATISTICS is defined
+ * before the library headers are included.
+ * @param[in] stat statistics (LCD::Statistics) to update.
+ * @param[in] bytes number of bytes.
+ */
+#if defined(LCD_STATISTICS)
+#define LCD_PROBE(stat, bytes) LCD::Statistics::Probe lcd_probe(stat, bytes)
+#else
+#define LCD_PROBE(stat, bytes) do {} while (0)
+#endif
+
+/**
+ * Record device operation statistics in the given scope. Only the
+ * outermost operation of the device is recorded; operations called
+ * by another operation of the same device (e.g. cursor_set() on
+ * new-line in write()) are not. Should be used in LCD::Device member
+ * functions.
+ * @param[in] op operation (LCD::Device::STAT_CURSOR_SET..STAT_FLUSH).
+ * @param[in] bytes number of bytes.
+ */
+#if defined(LCD_STATISTICS)
+#define LCD_DEVICE_PROBE(op, bytes)					\
+  LCD::Statistics::Probe lcd_probe(m_statistics[op], bytes, &m_depth)
+#else
+#define LCD_DEVICE_PROBE(op, bytes) do {} while (0)
+#endif
+
+namespace LCD {
+/**
+ * Operation statistics; number of calls, number of bytes and a
+ * latency histogram with log2 buckets in micro-seconds. Bucket n
+ * counts calls with latency 2^n..2^(n+1)-1 us, bucket zero also
+ * calls below 1 us, and the last bucket all longer calls. The
+ * counters saturate.
+ *
+ * @section Example
+ * @code
+ * #define LCD_STATISTICS
+ * #include "LCD.h"
+ * ...
+ * lcd.dump(Serial);
+ * @endcode
+ */
+class Statistics {
+public:
+  /** Number of latency histogram buckets. */
+  static const uint8_t BUCKET_MAX = 16;
+
+  /**
+   * Construct statistics with zero counters.
+   */
+  Statistics()
+  {
+    reset();
+  }
+
+  /**
+   * Reset counters.
+   */
+  void reset()
+  {
+    m_calls = 0;
+    m_bytes = 0;
+    memset(m_histogram, 0, sizeof(m_histogram));
+  }
+
+  /**
+   * Record call with given number of bytes and latency.
+   * @param[in] bytes number of bytes.
+   * @param[in] us latency in micro-seconds.
+   */
+  void record(uint16_t bytes, uint32_t us)
+  {
+    uint8_t ix = 0;
+    while ((us >>= 1) != 0 && ix < BUCKET_MAX - 1) ix++;
+    if (m_histogram[ix] != 0xffff) m_histogram[ix] += 1;
+    if (m_calls != 0xffffffffUL) m_calls += 1;
+    if (m_bytes <= 0xffffffffUL - bytes) m_bytes += bytes;
+  }
+
+  /**
+   * Return number of recorded calls.
+   * @return calls.
+   */
+  uint32_t calls() const
+  {
+    return (m_calls);
+  }
+
+  /**
+   * Return number of recorded bytes.
+   * @return bytes.
+   */
+  uint32_t bytes() const
+  {
+    return (m_bytes);
+  }
+
+  /**
+   * Return number of calls in given latency bucket.
+   * @param[in] ix bucket index (0..BUCKET_MAX-1).
+   * @return calls.
+   */
+  uint16_t bucket(uint8_t ix) const
+  {
+    return (ix < BUCKET_MAX ? m_histogram[ix] : 0);
+  }
+
+  /**
+   * Print statistics on a single line with given name; number of
+   * calls, bytes and the non-empty latency buckets as lower
+   * bound(us):calls.
+   * @param[in] out output stream.
+   * @param[in] name operation name.
+   */
+  void dump(Print& out, const __FlashStringHelper* name) const
+  {
+    out.print(name);
+    out.print(F(": calls="));
+    out.print(m_calls);
+    out.print(F(", bytes="));
+    out.print(m_bytes);
+    out.print(F(", us:"));
+    for (uint8_t ix = 0; ix < BUCKET_MAX; ix++) {
+      if (m_histogram[ix] == 0) continue;
+      out.print(' ');
+      out.print(1UL << ix);
+      out.print(':');
+      out.print(m_histogram[ix]);
+    }
+    out.println();
+  }
+
+  /**
+   * Scoped probe; measures latency from construction to destruction
+   * and records the call. With a nesting depth counter only the
+   * outermost probe records. See LCD_PROBE() and LCD_DEVICE_PROBE().
+   */
+  class Probe {
+  public:
+    /**
+     * Start measurement for given statistics and number of bytes.
+     * The call is not recorded if the given nesting depth counter is
+     * non-zero.
+     * @param[in] stat statistics to update.
+     * @param[in] bytes number of bytes.
+     * @param[in] depth nesting depth counter or NULL (Default NULL).
+     */
+    Probe(Statistics& stat, uint16_t bytes, uint8_t* depth = NULL) :
+      m_stat(depth == NULL || *depth == 0 ? &stat : NULL),
+      m_depth(depth),
+      m_bytes(bytes),
+      m_start(m_stat != NULL ? micros() : 0)
+    {
+      if (m_depth != NULL) *m_depth += 1;
+    }
+
+    /**
+     * Stop measurement and record call if outermost.
+     */
+    ~Probe()
+    {
+      if (m_depth != NULL) *m_depth -= 1;
+      if (m_stat != NULL) m_stat->record(m_bytes, micros() - m_start);
+    }
+
+  protected:
+    Statistics* m_stat;		//!< Statistics to update or NULL.
+    uint8_t* m_depth;		//!< Nesting depth counter or NULL.
+    uint16_t m_bytes;		//!< Number of bytes.
+    uint32_t m_start;		//!< Start of call (us).
+  };
+
+protected:
+  uint32_t m_calls;		//!< Number of calls.
+  uint32_t m_bytes;		//!< Number of bytes.
+  uint16_t m_histogram[BUCKET_MAX]; //!< Latency histogram.
+};
+};
+#endif
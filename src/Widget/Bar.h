@@ -0,0 +1,239 @@
+/**
+ * @file LCD/Widget/Bar.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef LCD_WIDGET_BAR_H
+#define LCD_WIDGET_BAR_H
+
+#include "LCD.h"
+#include "Driver/HD44780.h"
+
+namespace LCD {
+/**
+ * Horizontal bar graph for HD44780 with five steps per character
+ * (pixel columns). The partial cells use four custom characters,
+ * starting with the given identity, which are loaded once with
+ * begin(). Only the cells that change are written on update.
+ *
+ * @section Example
+ * @code
+ * LCD::HBar level(lcd, 0, 1, 16);
+ * ...
+ * level.begin();
+ * ...
+ * level.update(value, 1023);
+ * @endcode
+ */
+class HBar {
+public:
+  /** Number of steps per character. */
+  static const uint8_t STEPS = 5;
+
+  /** Max width in characters. */
+  static const uint8_t WIDTH_MAX = 40;
+
+  /**
+   * Construct horizontal bar at given position with given width on
+   * given display. Uses custom characters id..id+3.
+   * @param[in] lcd display device driver.
+   * @param[in] x position.
+   * @param[in] y position.
+   * @param[in] width number of characters (max WIDTH_MAX).
+   * @param[in] id first custom character (Default 0).
+   */
+  HBar(HD44780& lcd, uint8_t x, uint8_t y, uint8_t width, uint8_t id = 0) :
+    m_lcd(lcd),
+    m_x(x),
+    m_y(y),
+    m_width(width < WIDTH_MAX ? width : WIDTH_MAX),
+    m_id(id),
+    m_steps(UNKNOWN)
+  {}
+
+  /**
+   * Load partial cell shapes to the custom character memory. The
+   * next update will write all cells.
+   */
+  void begin()
+  {
+    uint8_t bitmap[HD44780::BITMAP_MAX];
+    for (uint8_t i = 1; i < STEPS; i++) {
+      memset(bitmap, (0x1f << (STEPS - i)) & 0x1f, sizeof(bitmap));
+      m_lcd.cgram_write(m_id + i - 1, 0, bitmap, sizeof(bitmap));
+    }
+    m_steps = UNKNOWN;
+  }
+
+  /**
+   * Update bar with given value in range 0..max. Returns number of
+   * characters written.
+   * @param[in] value to display.
+   * @param[in] max value for full bar.
+   * @return number of characters written.
+   */
+  size_t update(uint16_t value, uint16_t max)
+  {
+    uint16_t steps = m_width * STEPS;
+    if (value < max) steps = ((uint32_t) value * steps) / max;
+
+    // Locate changed cells; all if unknown
+    uint8_t first = 0;
+    uint8_t last = m_width;
+    if (m_steps != UNKNOWN) {
+      if (steps == m_steps) return (0);
+      uint16_t lo = (steps < m_steps ? steps : m_steps);
+      uint16_t hi = (steps < m_steps ? m_steps : steps);
+      first = lo / STEPS;
+      last = (hi + STEPS - 1) / STEPS;
+    }
+    m_steps = steps;
+
+    // Build and write changed cells
+    uint8_t buf[WIDTH_MAX];
+    uint8_t full = steps / STEPS;
+    uint8_t part = steps % STEPS;
+    for (uint8_t i = first; i < last; i++) {
+      uint8_t c = ' ';
+      if (i < full) c = FULL;
+      else if (i == full && part != 0) c = m_id + part - 1;
+      buf[i - first] = c;
+    }
+    m_lcd.ddram_write(m_x + first, m_y, buf, last - first);
+    return (last - first);
+  }
+
+protected:
+  /** Full block character. */
+  static const uint8_t FULL = 0xff;
+
+  /** Unknown number of steps. */
+  static const uint16_t UNKNOWN = 0xffff;
+
+  HD44780& m_lcd;		//!< Display device driver.
+  uint8_t m_x;			//!< Position x.
+  uint8_t m_y;			//!< Position y.
+  uint8_t m_width;		//!< Width in characters.
+  uint8_t m_id;			//!< First custom character.
+  uint16_t m_steps;		//!< Displayed number of steps.
+};
+
+/**
+ * Vertical bar graph for HD44780 with eight steps per character
+ * (pixel rows). The bar grows upwards from the bottom line. The
+ * partial cells use seven custom characters, starting with the given
+ * identity, which are loaded once with begin(). Only the cells that
+ * change are written on update.
+ *
+ * @section Example
+ * @code
+ * LCD::VBar tank(lcd, 15, 0, 2, 1);
+ * ...
+ * tank.begin();
+ * ...
+ * tank.update(level, 100);
+ * @endcode
+ */
+class VBar {
+public:
+  /** Number of steps per character. */
+  static const uint8_t STEPS = HD44780::BITMAP_MAX;
+
+  /**
+   * Construct vertical bar at given position (top line) with given
+   * height on given display. Uses custom characters id..id+6.
+   * @param[in] lcd display device driver.
+   * @param[in] x position.
+   * @param[in] y position of top line.
+   * @param[in] height number of lines.
+   * @param[in] id first custom character (Default 0).
+   */
+  VBar(HD44780& lcd, uint8_t x, uint8_t y, uint8_t height, uint8_t id = 0) :
+    m_lcd(lcd),
+    m_x(x),
+    m_y(y),
+    m_height(height),
+    m_id(id),
+    m_steps(UNKNOWN)
+  {}
+
+  /**
+   * Load partial cell shapes to the custom character memory. The
+   * next update will write all cells.
+   */
+  void begin()
+  {
+    uint8_t bitmap[HD44780::BITMAP_MAX];
+    for (uint8_t i = 1; i < STEPS; i++) {
+      memset(bitmap, 0, STEPS - i);
+      memset(bitmap + STEPS - i, 0x1f, i);
+      m_lcd.cgram_write(m_id + i - 1, 0, bitmap, sizeof(bitmap));
+    }
+    m_steps = UNKNOWN;
+  }
+
+  /**
+   * Update bar with given value in range 0..max. Returns number of
+   * characters written.
+   * @param[in] value to display.
+   * @param[in] max value for full bar.
+   * @return number of characters written.
+   */
+  size_t update(uint16_t value, uint16_t max)
+  {
+    uint16_t steps = m_height * STEPS;
+    if (value < max) steps = ((uint32_t) value * steps) / max;
+
+    // Locate changed cells (from bottom); all if unknown
+    uint8_t first = 0;
+    uint8_t last = m_height;
+    if (m_steps != UNKNOWN) {
+      if (steps == m_steps) return (0);
+      uint16_t lo = (steps < m_steps ? steps : m_steps);
+      uint16_t hi = (steps < m_steps ? m_steps : steps);
+      first = lo / STEPS;
+      last = (hi + STEPS - 1) / STEPS;
+    }
+    m_steps = steps;
+
+    // Write changed cells, one per line
+    uint8_t full = steps / STEPS;
+    uint8_t part = steps % STEPS;
+    for (uint8_t i = first; i < last; i++) {
+      uint8_t c = ' ';
+      if (i < full) c = FULL;
+      else if (i == full && part != 0) c = m_id + part - 1;
+      m_lcd.ddram_write(m_x, m_y + m_height - 1 - i, &c, 1);
+    }
+    return (last - first);
+  }
+
+protected:
+  /** Full block character. */
+  static const uint8_t FULL = 0xff;
+
+  /** Unknown number of steps. */
+  static const uint16_t UNKNOWN = 0xffff;
+
+  HD44780& m_lcd;		//!< Display device driver.
+  uint8_t m_x;			//!< Position x.
+  uint8_t m_y;			//!< Position of top line.
+  uint8_t m_height;		//!< Height in lines.
+  uint8_t m_id;			//!< First custom character.
+  uint16_t m_steps;		//!< Displayed number of steps.
+};
+};
+#endif
@@ -0,0 +1,224 @@
+/**
+ * @file LCD/Widget/BigNumber.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef LCD_WIDGET_BIG_NUMBER_H
+#define LCD_WIDGET_BIG_NUMBER_H
+
+#include "LCD.h"
+#include "Driver/HD44780.h"
+
+/**
+ * Big number renderer for HD44780. Digits are two or three lines high
+ * and three columns wide, with one column between digits. The digits
+ * are composed from seven segment shapes in the custom character
+ * memory (CGRAM), the block (0xff) and space characters. The shapes
+ * are shared by all big numbers and loaded with begin(). Custom
+ * character 7 is not used and is free for the application. Only the
+ * digits that have changed since the last update are written.
+ *
+ * @param[in] DIGITS number of digits.
+ *
+ * @section Example
+ * @code
+ * LCD::BigNumber<4> counter(lcd, 0, 1, 3);
+ * ...
+ * counter.begin();
+ * ...
+ * counter.update(value);
+ * @endcode
+ */
+namespace LCD {
+template<uint8_t DIGITS>
+class BigNumber {
+public:
+  /** Digit width and column step (characters). */
+  static const uint8_t DIGIT_WIDTH = 3;
+  static const uint8_t DIGIT_STEP = DIGIT_WIDTH + 1;
+
+  /**
+   * Construct big number at given position with given height (two
+   * or three lines) on given display.
+   * @param[in] lcd display device driver.
+   * @param[in] x position of first digit.
+   * @param[in] y position of top line.
+   * @param[in] rows number of lines per digit, 2 or 3 (Default 2).
+   */
+  BigNumber(HD44780& lcd, uint8_t x, uint8_t y, uint8_t rows = 2) :
+    m_lcd(lcd),
+    m_x(x),
+    m_y(y),
+    m_rows(rows == 3 ? 3 : 2)
+  {
+    invalidate();
+  }
+
+  /**
+   * Load segment shapes to the display custom character memory. Uses
+   * custom characters 0..6. The next update will write all digits.
+   */
+  void begin()
+  {
+    static const uint8_t shape[] PROGMEM = {
+      0x07, 0x0f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, // Left top
+      0x1f, 0x1f, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, // Upper bar
+      0x1c, 0x1e, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, // Right top
+      0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x0f, 0x07, // Left low
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x1f, 0x1f, // Lower bar
+      0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1e, 0x1c, // Right low
+      0x1f, 0x1f, 0x1f, 0x00, 0x00, 0x00, 0x1f, 0x1f  // Upper middle bars
+    };
+    for (uint8_t id = 0; id < SHAPE_MAX; id++)
+      m_lcd.set_custom_char_P(id, &shape[id * HD44780::BITMAP_MAX]);
+    invalidate();
+  }
+
+  /**
+   * Mark displayed digits as unknown. The next update will write all
+   * digits. Should be called when the display has been cleared.
+   */
+  void invalidate()
+  {
+    memset(m_digit, UNKNOWN, sizeof(m_digit));
+  }
+
+  /**
+   * Update big number with given value. Leading zeros are blank. Only
+   * the low DIGITS digits are shown. The changed digits are written
+   * in one output batch and the display cursor is restored. Returns
+   * number of characters written.
+   * @param[in] value to display.
+   * @return number of characters written.
+   */
+  size_t update(uint32_t value)
+  {
+    size_t res = 0;
+    uint8_t ix = DIGITS;
+    m_lcd.begin_batch();
+    do {
+      ix -= 1;
+      res += render(ix, value % 10);
+      value /= 10;
+    } while (ix != 0 && value != 0);
+    while (ix != 0) res += render(--ix, BLANK);
+    if (res != 0) m_lcd.cursor_restore();
+    m_lcd.end_batch();
+    return (res);
+  }
+
+  /**
+   * Update digit with given index (0..DIGITS-1, left to right) with
+   * given value (0..9 or BLANK). Nothing is written if the digit has
+   * not changed. The display cursor is restored. Returns number of
+   * characters written.
+   * @param[in] ix digit index.
+   * @param[in] value digit value.
+   * @return number of characters written.
+   */
+  size_t digit(uint8_t ix, uint8_t value)
+  {
+    m_lcd.begin_batch();
+    size_t res = render(ix, value);
+    if (res != 0) m_lcd.cursor_restore();
+    m_lcd.end_batch();
+    return (res);
+  }
+
+  /** Blank digit value. */
+  static const uint8_t BLANK = 10;
+
+protected:
+  /**
+   * Write digit with given index and value to display data memory if
+   * changed. Returns number of characters written.
+   * @param[in] ix digit index.
+   * @param[in] value digit value.
+   * @return number of characters written.
+   */
+  size_t render(uint8_t ix, uint8_t value)
+  {
+    if (ix >= DIGITS || m_digit[ix] == value) return (0);
+    m_digit[ix] = value;
+    static const uint8_t font2[] PROGMEM = {
+      LT, UB, RT,  LL, LB, LR,		// 0
+      UB, RT, SP,  LB, FB, LB,		// 1
+      UMB, UMB, RT,  LL, LB, LB,	// 2
+      UMB, UMB, RT,  LB, LB, LR,	// 3
+      LL, LB, FB,  SP, SP, FB,		// 4
+      LL, UMB, UMB,  LB, LB, LR,	// 5
+      LT, UMB, UMB,  LL, LB, LR,	// 6
+      UB, UB, RT,  SP, SP, FB,		// 7
+      LT, UMB, RT,  LL, LB, LR,		// 8
+      LT, UMB, RT,  SP, SP, FB		// 9
+    };
+    static const uint8_t font3[] PROGMEM = {
+      LT, UB, RT,  FB, SP, FB,  LL, LB, LR,	// 0
+      UB, RT, SP,  SP, FB, SP,  LB, FB, LB,	// 1
+      UB, UB, RT,  LT, UB, LR,  LL, LB, LB,	// 2
+      UB, UB, RT,  SP, UB, FB,  LB, LB, LR,	// 3
+      FB, SP, FB,  LL, LB, FB,  SP, SP, FB,	// 4
+      FB, UB, UB,  UB, UB, RT,  LB, LB, LR,	// 5
+      LT, UB, UB,  FB, UB, RT,  LL, LB, LR,	// 6
+      UB, UB, RT,  SP, SP, FB,  SP, SP, FB,	// 7
+      LT, UB, RT,  FB, UMB, FB,  LL, LB, LR,	// 8
+      LT, UB, RT,  LL, LB, FB,  LB, LB, LR	// 9
+    };
+    uint8_t buf[DIGIT_WIDTH];
+    const uint8_t* glyph = NULL;
+    if (value < 10) {
+      glyph = (m_rows == 2 ? font2 : font3);
+      glyph += value * m_rows * DIGIT_WIDTH;
+    }
+    uint8_t x = m_x + ix * DIGIT_STEP;
+    for (uint8_t y = 0; y < m_rows; y++) {
+      if (glyph != NULL) {
+	memcpy_P(buf, glyph, DIGIT_WIDTH);
+	glyph += DIGIT_WIDTH;
+      }
+      else {
+	memset(buf, SP, DIGIT_WIDTH);
+      }
+      m_lcd.ddram_write(x, m_y + y, buf, DIGIT_WIDTH);
+    }
+    return (m_rows * DIGIT_WIDTH);
+  }
+
+  /** Segment shapes (custom characters), block and space. */
+  enum {
+    LT = 0,			//!< Left top.
+    UB = 1,			//!< Upper bar.
+    RT = 2,			//!< Right top.
+    LL = 3,			//!< Left low.
+    LB = 4,			//!< Lower bar.
+    LR = 5,			//!< Right low.
+    UMB = 6,			//!< Upper and middle bar.
+    SHAPE_MAX = 7,		//!< Number of segment shapes.
+    SP = 0x20,			//!< Space.
+    FB = 0xff			//!< Full block.
+  } __attribute__((packed));
+
+  /** Unknown digit value. */
+  static const uint8_t UNKNOWN = 0xff;
+
+  HD44780& m_lcd;		//!< Display device driver.
+  uint8_t m_x;			//!< Position of first digit.
+  uint8_t m_y;			//!< Position of top line.
+  uint8_t m_rows;		//!< Number of lines per digit.
+  uint8_t m_digit[DIGITS];	//!< Displayed digit values.
+};
+};
+#endif
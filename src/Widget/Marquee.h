@@ -0,0 +1,224 @@
+/**
+ * @file LCD/Widget/Marquee.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef LCD_WIDGET_MARQUEE_H
+#define LCD_WIDGET_MARQUEE_H
+
+#include "LCD.h"
+#include "Driver/HD44780.h"
+
+/**
+ * Marquee for HD44780 with one or two lines; scroll a long text with
+ * the controller display shift. The text is written to the 40
+ * column display data memory (DDRAM) line and each scroll step is a
+ * single shift command. New characters are written to the columns
+ * outside the visible window ahead of the scroll, in runs that fill
+ * all free columns. A scroll step costs about two bytes on the bus
+ * on average, one for the shift and one for the new character.
+ *
+ * The display shift moves all lines. Other lines will scroll with
+ * the marquee; they should be blank or hold text that is repeated
+ * over all 40 columns.
+ *
+ * On displays with a split line (e.g. 16x1 with two 8 character
+ * halves) the display shift would move the halves separately. The
+ * visible window is then rewritten on each scroll step instead; a
+ * step costs the display width plus two cursor positioning bytes.
+ *
+ * @section Example
+ * @code
+ * LCD::Marquee news(lcd, 0, 300);
+ * ...
+ * news.begin(text);
+ * ...
+ * void loop()
+ * {
+ *   news.tick();
+ *   ...
+ * }
+ * @endcode
+ */
+namespace LCD {
+class Marquee {
+public:
+  /** Number of DDRAM columns per line. */
+  static const uint8_t DDRAM_COLS = 40;
+
+  /**
+   * Construct marquee on given line of given display with given
+   * scroll step period.
+   * @param[in] lcd display device driver.
+   * @param[in] y line (0 or 1).
+   * @param[in] period scroll step period in milli-seconds.
+   */
+  Marquee(HD44780& lcd, uint8_t y, uint16_t period) :
+    m_lcd(lcd),
+    m_y(y),
+    m_period(period),
+    m_text(NULL),
+    m_length(0),
+    m_next(0),
+    m_col(0),
+    m_prep(0),
+    m_timestamp(0),
+    m_shift(lcd.split() == lcd.WIDTH)
+  {}
+
+  /**
+   * Start scrolling given text. The text is followed by a gap of
+   * blank characters, the width of the display, before it is
+   * repeated. Text that fits the display is not scrolled. The
+   * display shift is reset with cursor home. On a split line display
+   * the visible window is written. The text buffer must
+   * be valid while the marquee is running.
+   * @param[in] text null terminated string.
+   */
+  void begin(const char* text)
+  {
+    m_text = text;
+    m_length = strlen(text);
+    m_next = 0;
+    m_timestamp = millis();
+    if (!m_shift) {
+      render();
+      return;
+    }
+    m_lcd.cursor_home();
+    m_col = 0;
+    fill(DDRAM_COLS);
+    m_prep = DDRAM_COLS - m_lcd.WIDTH;
+  }
+
+  /**
+   * Stop scrolling.
+   */
+  void end()
+  {
+    m_text = NULL;
+  }
+
+  /**
+   * Scroll one step if the period has elapsed. Should be called
+   * frequently. Returns true if the display was shifted otherwise
+   * false.
+   * @return bool.
+   */
+  bool tick()
+  {
+    if (m_text == NULL || m_length <= m_lcd.WIDTH) return (false);
+    uint16_t now = millis();
+    if ((uint16_t) (now - m_timestamp) < m_period) return (false);
+    m_timestamp = now;
+    step();
+    return (true);
+  }
+
+  /**
+   * Scroll one step. The free columns outside the visible window are
+   * written when all have been scrolled into view. Without display
+   * shift the visible window is rewritten.
+   */
+  void step()
+  {
+    if (!m_shift) {
+      if (++m_next == m_length + m_lcd.WIDTH) m_next = 0;
+      render();
+      return;
+    }
+    if (m_prep == 0) {
+      m_prep = DDRAM_COLS - m_lcd.WIDTH;
+      fill(m_prep);
+    }
+    m_lcd.display_scroll_left();
+    m_prep -= 1;
+  }
+
+protected:
+  /**
+   * Return text character with given index in the text loop; text
+   * followed by blank gap.
+   * @param[in] ix index.
+   * @return character.
+   */
+  char text(uint16_t ix) const
+  {
+    return (ix < m_length ? m_text[ix] : ' ');
+  }
+
+  /**
+   * Write given number of the next characters of the text loop to
+   * the DDRAM columns ahead of the visible window. The run is split
+   * where the DDRAM line wraps.
+   * @param[in] n number of characters.
+   */
+  void fill(uint8_t n)
+  {
+    uint8_t buf[DDRAM_COLS];
+    uint16_t loop = m_length + m_lcd.WIDTH;
+    while (n != 0) {
+      uint8_t m = DDRAM_COLS - m_col;
+      if (m > n) m = n;
+      for (uint8_t i = 0; i < m; i++) {
+	buf[i] = text(m_next);
+	if (++m_next == loop) m_next = 0;
+      }
+      m_lcd.ddram_write(m_col, m_y, buf, m);
+      m_col += m;
+      if (m_col == DDRAM_COLS) m_col = 0;
+      n -= m;
+    }
+  }
+
+  /**
+   * Write the visible window of the text loop, starting with the
+   * next index, with the cursor on the marquee line. The display
+   * cursor is restored.
+   */
+  void render()
+  {
+    uint8_t buf[DDRAM_COLS];
+    uint8_t width = m_lcd.WIDTH;
+    uint16_t loop = m_length + width;
+    uint16_t ix = m_next;
+    uint8_t x, y;
+    if (width > sizeof(buf)) width = sizeof(buf);
+    for (uint8_t i = 0; i < width; i++) {
+      buf[i] = text(ix);
+      if (++ix == loop) ix = 0;
+    }
+    m_lcd.cursor_get(x, y);
+    m_lcd.begin_batch();
+    m_lcd.cursor_set(0, m_y);
+    m_lcd.write(buf, width);
+    m_lcd.cursor_set(x, y);
+    m_lcd.end_batch();
+  }
+
+  HD44780& m_lcd;		//!< Display device driver.
+  uint8_t m_y;			//!< Marquee line.
+  uint16_t m_period;		//!< Scroll step period (ms).
+  const char* m_text;		//!< Text or NULL.
+  uint16_t m_length;		//!< Text length.
+  uint16_t m_next;		//!< Next text loop index to write.
+  uint8_t m_col;		//!< Next DDRAM column to write.
+  uint8_t m_prep;		//!< Written columns ahead of window.
+  uint16_t m_timestamp;		//!< Latest scroll step (ms).
+  bool m_shift;			//!< Scroll with display shift (no split line).
+};
+};
+#endif
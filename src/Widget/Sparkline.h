@@ -0,0 +1,148 @@
+/**
+ * @file LCD/Widget/Sparkline.h
+ * @version 1.0
+ *
+ * @section License
+ * Copyright (C) 2017, Mikael Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef LCD_WIDGET_SPARKLINE_H
+#define LCD_WIDGET_SPARKLINE_H
+
+#include "LCD.h"
+#include "Driver/HD44780.h"
+
+/**
+ * Sparkline for HD44780; a small trend graph of the latest samples
+ * drawn in custom characters used as a bitmap. Each character is
+ * five samples wide and eight steps high. The characters are written
+ * to the display once with begin(). A new sample shifts the graph
+ * left and only the custom character bitmap rows that change are
+ * written.
+ *
+ * @param[in] CELLS number of characters (1..8, Default 8).
+ *
+ * @section Example
+ * @code
+ * LCD::Sparkline<> trend(lcd, 8, 1);
+ * ...
+ * trend.begin();
+ * ...
+ * trend.push(value, 1023);
+ * @endcode
+ */
+namespace LCD {
+template<uint8_t CELLS = 8>
+class Sparkline {
+  static_assert(CELLS >= 1 && CELLS <= 8,
+		"LCD::Sparkline: custom character cells not in 1..8");
+public:
+  /** Number of samples per character and steps per sample. */
+  static const uint8_t COLUMNS = 5;
+  static const uint8_t STEPS = HD44780::BITMAP_MAX;
+
+  /** Number of samples in graph. */
+  static const uint8_t SAMPLES = CELLS * COLUMNS;
+
+  /**
+   * Construct sparkline at given position on given display. Uses
+   * custom characters id..id+CELLS-1.
+   * @param[in] lcd display device driver.
+   * @param[in] x position.
+   * @param[in] y position.
+   * @param[in] id first custom character (Default 0).
+   */
+  Sparkline(HD44780& lcd, uint8_t x, uint8_t y, uint8_t id = 0) :
+    m_lcd(lcd),
+    m_x(x),
+    m_y(y),
+    m_id(id)
+  {
+    memset(m_sample, 0, sizeof(m_sample));
+  }
+
+  /**
+   * Write the custom characters of the graph to the display and
+   * all bitmap rows to the custom character memory.
+   */
+  void begin()
+  {
+    uint8_t buf[CELLS];
+    for (uint8_t i = 0; i < CELLS; i++) buf[i] = m_id + i;
+    m_lcd.ddram_write(m_x, m_y, buf, CELLS);
+    memset(m_bitmap, UNKNOWN, sizeof(m_bitmap));
+    render();
+  }
+
+  /**
+   * Add sample with given value in range 0..max. The graph is
+   * shifted left. Returns number of bitmap rows written.
+   * @param[in] value sample.
+   * @param[in] max value for full height.
+   * @return number of bitmap rows written.
+   */
+  size_t push(uint16_t value, uint16_t max)
+  {
+    uint8_t steps = STEPS;
+    if (value < max) steps = ((uint32_t) value * STEPS) / max;
+    memmove(m_sample, m_sample + 1, SAMPLES - 1);
+    m_sample[SAMPLES - 1] = steps;
+    return (render());
+  }
+
+protected:
+  /** Unknown bitmap row. */
+  static const uint8_t UNKNOWN = 0xff;
+
+  /**
+   * Build bitmap of samples and write the changed rows to the custom
+   * character memory. Consecutive changed rows are written with a
+   * single transfer. Returns number of rows written.
+   * @return number of rows written.
+   */
+  size_t render()
+  {
+    uint8_t bitmap[CELLS * STEPS];
+    memset(bitmap, 0, sizeof(bitmap));
+    for (uint8_t i = 0; i < SAMPLES; i++) {
+      uint8_t mask = 0x10 >> (i % COLUMNS);
+      uint8_t* cell = &bitmap[(i / COLUMNS) * STEPS];
+      for (uint8_t row = STEPS - m_sample[i]; row < STEPS; row++)
+	cell[row] |= mask;
+    }
+    size_t res = 0;
+    uint8_t i = 0;
+    while (i < sizeof(bitmap)) {
+      if (bitmap[i] == m_bitmap[i]) {
+	i++;
+	continue;
+      }
+      uint8_t n = 1;
+      while (i + n < sizeof(bitmap) && bitmap[i + n] != m_bitmap[i + n]) n++;
+      memcpy(&m_bitmap[i], &bitmap[i], n);
+      m_lcd.cgram_write(m_id, i, &bitmap[i], n);
+      res += n;
+      i += n;
+    }
+    return (res);
+  }
+
+  HD44780& m_lcd;		//!< Display device driver.
+  uint8_t m_x;			//!< Position x.
+  uint8_t m_y;			//!< Position y.
+  uint8_t m_id;			//!< First custom character.
+  uint8_t m_sample[SAMPLES];	//!< Samples (steps).
+  uint8_t m_bitmap[CELLS * STEPS]; //!< Custom character bitmap rows.
+};
+};
+#endif